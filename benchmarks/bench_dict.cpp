@@ -0,0 +1,680 @@
+#include "dictcpp.hpp"
+#include "concurrent_dict.hpp"
+#include "frozen_dict.hpp"
+
+#include <map>
+#include <array>
+#include <chrono>
+#include <limits>
+#include <compare>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <thread>
+#include <shared_mutex>
+#include <iostream>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+/// Benchmarks for `dictcpp::Dict`, compared against `std::unordered_map` and `std::map`.
+///
+/// Usage: DictBenchmarks [--max-size N] [--min-time-ms T] [--filter TEXT] [--output FILE]
+///
+/// Every operation is timed for sizes 8, 64, ..., 2097152 up to `--max-size` (default 1048576, which
+/// is also timed; the full suite uses 10000000) and for `int`, `char`, `std::string` and 64-byte
+/// struct keys/values. `char` keys only have 256 distinct values, so are limited to small sizes.
+/// `FrozenDict` is timed for its read operations only. `ConcurrentDict` is timed separately on 1, 2, 4, ... threads, against a `Dict` behind one lock.
+/// Results are printed one per line and written to a JSON file (default: `bench_results.json`).
+
+namespace {
+/// A 64-byte key/value type, to measure the cost of moving large entries
+struct LargeStruct {
+    std::array<std::uint64_t, 8> data{};
+
+    bool operator==(const LargeStruct &other) const = default;
+
+    auto operator<=>(const LargeStruct &other) const = default;
+};
+}
+
+template<>
+struct std::hash<LargeStruct> {
+    size_t operator()(const LargeStruct &value) const noexcept {
+        size_t hash = 0;
+        for (const auto element: value.data) {
+            hash = hash * 1099511628211ULL ^ std::hash<std::uint64_t>{}(element);
+        }
+        return hash;
+    }
+};
+
+namespace {
+volatile size_t sink = 0;
+
+size_t checksum(const int value) {
+    return static_cast<size_t>(value);
+}
+
+size_t checksum(const char value) {
+    return static_cast<size_t>(value);
+}
+
+size_t checksum(const std::string &value) {
+    return value.size();
+}
+
+size_t checksum(const LargeStruct &value) {
+    return value.data[0];
+}
+
+/// Creates a key (or value) of type `T`, distinct seeds give distinct results
+template<typename T>
+T make(std::uint64_t seed);
+
+template<>
+int make<int>(const std::uint64_t seed) {
+    return static_cast<int>(seed * 2654435761ULL % 2147483647ULL);
+}
+
+template<>
+char make<char>(const std::uint64_t seed) {
+    return static_cast<char>(seed);
+}
+
+template<>
+std::string make<std::string>(const std::uint64_t seed) {
+    return "benchmark_key_" + std::to_string(seed * 2654435761ULL);
+}
+
+template<>
+LargeStruct make<LargeStruct>(const std::uint64_t seed) {
+    LargeStruct value;
+    for (size_t i = 0; i < value.data.size(); ++i) {
+        value.data[i] = seed * (i + 1);
+    }
+    return value;
+}
+
+template<typename T>
+constexpr size_t max_distinct() {
+    if constexpr (std::is_same_v<T, char>) {
+        return 256;
+    } else {
+        return std::numeric_limits<size_t>::max();
+    }
+}
+
+template<typename Key, typename Value>
+struct Data {
+    std::vector<dictcpp::Item<Key, Value>> items;
+    std::vector<Key> hits;
+    std::vector<Key> misses;
+    // Half of the keys are shared with `items`
+    std::vector<dictcpp::Item<Key, Value>> other;
+};
+
+/// Keys are taken from seeds `[0, 2 * size)`: the first half are present, the rest are misses
+template<typename Key, typename Value>
+Data<Key, Value> make_data(const size_t size) {
+    std::vector<std::uint64_t> seeds(2 * size);
+    for (size_t i = 0; i < seeds.size(); ++i) {
+        seeds[i] = i;
+    }
+    std::mt19937_64 generator(42);
+    std::shuffle(seeds.begin(), seeds.end(), generator);
+
+    Data<Key, Value> data;
+    data.items.reserve(size);
+    data.other.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        data.items.push_back({make<Key>(seeds[i]), make<Value>(seeds[i] + 1)});
+        data.misses.push_back(make<Key>(seeds[size + i]));
+        data.other.push_back({make<Key>(seeds[i / 2 + (i % 2) * size]), make<Value>(i)});
+    }
+
+    data.hits.reserve(size);
+    for (const auto &[key, value]: data.items) {
+        data.hits.push_back(key);
+    }
+    std::shuffle(data.hits.begin(), data.hits.end(), generator);
+
+    return data;
+}
+
+template<typename T>
+struct is_dict : std::false_type {
+};
+
+template<typename Key, typename Value>
+struct is_dict<dictcpp::Dict<Key, Value> > : std::true_type {
+};
+
+/// Builds a container from a list of items, using the natural bulk constructor of each
+template<typename Container, typename Key, typename Value>
+Container build(const std::vector<dictcpp::Item<Key, Value>> &items) {
+    if constexpr (is_dict<Container>::value) {
+        return Container(items);
+    } else {
+        Container container;
+        for (const auto &[key, value]: items) {
+            container.insert_or_assign(key, value);
+        }
+        return container;
+    }
+}
+
+template<typename Container, typename Key, typename Value>
+void update(Container &container, const Container &other) {
+    if constexpr (is_dict<Container>::value) {
+        container.update(other);
+    } else {
+        for (const auto &[key, value]: other) {
+            container.insert_or_assign(key, value);
+        }
+    }
+}
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    std::string operation;
+    std::string container;
+    std::string key_type;
+    size_t size = 0;
+    size_t iterations = 0;
+    double ns_per_op = 0;
+};
+
+struct Options {
+    size_t max_size = 1 << 20;
+    double min_time_ms = 20;
+    std::string filter;
+    std::string output = "bench_results.json";
+};
+
+class Runner {
+    Options options;
+    std::vector<Result> results;
+
+public:
+    explicit Runner(Options options): options(std::move(options)) {
+    }
+
+    /// Runs `step` until the accumulated time reaches the minimum. `step` adds the time of its
+    /// measured part to the given duration (so set-up work is not counted) and returns the
+    /// number of operations performed.
+    template<typename Step>
+    void run(const std::string &operation, const std::string &container, const std::string &key_type,
+             const size_t size, Step step) {
+        const auto name = operation + "/" + container + "/" + key_type + "/" + std::to_string(size);
+        if (!options.filter.empty() && name.find(options.filter) == std::string::npos) {
+            return;
+        }
+
+        Clock::duration elapsed{};
+        size_t operations = 0;
+        size_t iterations = 0;
+        const auto min_time = std::chrono::duration<double, std::milli>(options.min_time_ms);
+        while (iterations == 0 || elapsed < min_time) {
+            operations += step(elapsed);
+            iterations++;
+        }
+
+        const auto ns = std::chrono::duration<double, std::nano>(elapsed).count();
+        results.push_back({operation, container, key_type, size, iterations, ns / static_cast<double>(operations)});
+        std::cout << name << ": " << results.back().ns_per_op << " ns/op" << std::endl;
+    }
+
+    [[nodiscard]] const Options &get_options() const {
+        return options;
+    }
+
+    void write_json() const {
+        std::ofstream file(options.output);
+        file << "{\n  \"context\": {\n";
+        file << "    \"library\": \"DictCPP\",\n";
+        file << "    \"max_size\": " << options.max_size << ",\n";
+        file << "    \"min_time_ms\": " << options.min_time_ms << "\n  },\n";
+        file << "  \"benchmarks\": [\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto &result = results[i];
+            file << "    {\"operation\": \"" << result.operation << "\", \"container\": \"" << result.container
+                    << "\", \"key_type\": \"" << result.key_type << "\", \"size\": " << result.size
+                    << ", \"iterations\": " << result.iterations << ", \"ns_per_op\": " << result.ns_per_op << "}"
+                    << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        file << "  ]\n}\n";
+    }
+};
+
+/// Adds the lifetime of the timer to `elapsed`
+class Timer {
+    Clock::duration &elapsed;
+    Clock::time_point start;
+
+public:
+    explicit Timer(Clock::duration &elapsed): elapsed(elapsed), start(Clock::now()) {
+    }
+
+    ~Timer() {
+        elapsed += Clock::now() - start;
+    }
+
+    Timer(const Timer &) = delete;
+
+    Timer &operator=(const Timer &) = delete;
+};
+
+template<typename Container, typename Key, typename Value>
+void run_container(Runner &runner, const std::string &container_name, const std::string &key_name,
+                   const Data<Key, Value> &data) {
+    const auto size = data.items.size();
+    const auto base = build<Container>(data.items);
+    const auto other = build<Container>(data.other);
+    const auto run = [&](const std::string &operation, auto step) {
+        runner.run(operation, container_name, key_name, size, step);
+    };
+
+    run("construct", [&](Clock::duration &elapsed) {
+        Timer timer(elapsed);
+        const auto container = build<Container>(data.items);
+        sink = sink + container.size();
+        return size;
+    });
+
+    run("subscript_hit", [&](Clock::duration &elapsed) {
+        Timer timer(elapsed);
+        size_t sum = 0;
+        for (const auto &key: data.hits) {
+            if constexpr (is_dict<Container>::value) {
+                sum += checksum(base[key]);
+            } else {
+                sum += checksum(base.at(key));
+            }
+        }
+        sink = sink + sum;
+        return size;
+    });
+
+    run("subscript_miss", [&](Clock::duration &elapsed) {
+        auto container = base;
+        Timer timer(elapsed);
+        for (const auto &key: data.misses) {
+            container[key] = data.items.front().value;
+        }
+        sink = sink + container.size();
+        return size;
+    });
+
+    run("get", [&](Clock::duration &elapsed) {
+        Timer timer(elapsed);
+        size_t sum = 0;
+        const auto &fallback = data.items.front().value;
+        for (size_t i = 0; i < size; ++i) {
+            const auto &key = i % 2 ? data.hits[i] : data.misses[i];
+            if constexpr (is_dict<Container>::value) {
+                sum += checksum(base.get(key, fallback));
+            } else {
+                const auto it = base.find(key);
+                sum += checksum(it != base.end() ? it->second : fallback);
+            }
+        }
+        sink = sink + sum;
+        return size;
+    });
+
+    run("contains", [&](Clock::duration &elapsed) {
+        Timer timer(elapsed);
+        size_t sum = 0;
+        for (size_t i = 0; i < size; ++i) {
+            sum += base.contains(i % 2 ? data.hits[i] : data.misses[i]);
+        }
+        sink = sink + sum;
+        return size;
+    });
+
+    run("del", [&](Clock::duration &elapsed) {
+        auto container = base;
+        Timer timer(elapsed);
+        for (const auto &key: data.hits) {
+            if constexpr (is_dict<Container>::value) {
+                container.del(key);
+            } else {
+                container.erase(key);
+            }
+        }
+        sink = sink + container.size();
+        return size;
+    });
+
+    run("pop", [&](Clock::duration &elapsed) {
+        auto container = base;
+        Timer timer(elapsed);
+        size_t sum = 0;
+        for (const auto &key: data.hits) {
+            if constexpr (is_dict<Container>::value) {
+                sum += checksum(container.pop(key));
+            } else {
+                const auto it = container.find(key);
+                const auto value = std::move(it->second);
+                container.erase(it);
+                sum += checksum(value);
+            }
+        }
+        sink = sink + sum;
+        return size;
+    });
+
+    run("popitem", [&](Clock::duration &elapsed) {
+        auto container = base;
+        Timer timer(elapsed);
+        size_t sum = 0;
+        while (!container.empty()) {
+            if constexpr (is_dict<Container>::value) {
+                sum += checksum(container.popitem().key);
+            } else if constexpr (std::is_same_v<Container, std::map<Key, Value> >) {
+                const auto it = std::prev(container.end());
+                sum += checksum(it->first);
+                container.erase(it);
+            } else {
+                const auto it = container.begin();
+                sum += checksum(it->first);
+                container.erase(it);
+            }
+        }
+        sink = sink + sum;
+        return size;
+    });
+
+    run("setdefault", [&](Clock::duration &elapsed) {
+        auto container = base;
+        Timer timer(elapsed);
+        size_t sum = 0;
+        const auto &fallback = data.items.front().value;
+        for (size_t i = 0; i < size; ++i) {
+            const auto &key = i % 2 ? data.hits[i] : data.misses[i];
+            if constexpr (is_dict<Container>::value) {
+                sum += checksum(container.setdefault(key, fallback));
+            } else {
+                sum += checksum(container.try_emplace(key, fallback).first->second);
+            }
+        }
+        sink = sink + sum;
+        return size;
+    });
+
+    run("update", [&](Clock::duration &elapsed) {
+        auto container = base;
+        Timer timer(elapsed);
+        update<Container, Key, Value>(container, other);
+        sink = sink + container.size();
+        return size;
+    });
+
+    run("merge_operator", [&](Clock::duration &elapsed) {
+        Timer timer(elapsed);
+        if constexpr (is_dict<Container>::value) {
+            const auto merged = base | other;
+            sink = sink + merged.size();
+        } else {
+            auto merged = base;
+            update<Container, Key, Value>(merged, other);
+            sink = sink + merged.size();
+        }
+        return size;
+    });
+
+    run("keys", [&](Clock::duration &elapsed) {
+        Timer timer(elapsed);
+        size_t sum = 0;
+        if constexpr (is_dict<Container>::value) {
+            for (const auto &key: base.keys()) {
+                sum += checksum(key);
+            }
+        } else {
+            std::vector<Key> keys;
+            keys.reserve(base.size());
+            for (const auto &[key, value]: base) {
+                keys.push_back(key);
+            }
+            sum += keys.size();
+        }
+        sink = sink + sum;
+        return size;
+    });
+
+    run("values", [&](Clock::duration &elapsed) {
+        Timer timer(elapsed);
+        size_t sum = 0;
+        if constexpr (is_dict<Container>::value) {
+            for (const auto &value: base.values()) {
+                sum += checksum(value);
+            }
+        } else {
+            std::vector<Value> values;
+            values.reserve(base.size());
+            for (const auto &[key, value]: base) {
+                values.push_back(value);
+            }
+            sum += values.size();
+        }
+        sink = sink + sum;
+        return size;
+    });
+
+    run("items", [&](Clock::duration &elapsed) {
+        Timer timer(elapsed);
+        size_t sum = 0;
+        if constexpr (is_dict<Container>::value) {
+            for (const auto &[key, value]: base.items()) {
+                sum += checksum(key) + checksum(value);
+            }
+        } else {
+            std::vector<dictcpp::Item<Key, Value>> items;
+            items.reserve(base.size());
+            for (const auto &[key, value]: base) {
+                items.push_back({key, value});
+            }
+            sum += items.size();
+        }
+        sink = sink + sum;
+        return size;
+    });
+
+    run("iterate", [&](Clock::duration &elapsed) {
+        Timer timer(elapsed);
+        size_t sum = 0;
+        if constexpr (is_dict<Container>::value) {
+            for (const auto &key: base) {
+                sum += checksum(key);
+            }
+        } else {
+            for (const auto &[key, value]: base) {
+                sum += checksum(key);
+            }
+        }
+        sink = sink + sum;
+        return size;
+    });
+}
+
+/// Times the construction and lookups of a `FrozenDict` (which has no other operations)
+template<typename Key, typename Value>
+void run_frozen(Runner &runner, const std::string &key_name, const Data<Key, Value> &data) {
+    using Frozen = dictcpp::FrozenDict<Key, Value>;
+    const auto size = data.items.size();
+    const Frozen base(data.items);
+    const auto run = [&](const std::string &operation, auto step) {
+        runner.run(operation, "FrozenDict", key_name, size, step);
+    };
+
+    run("construct", [&](Clock::duration &elapsed) {
+        Timer timer(elapsed);
+        const Frozen container(data.items);
+        sink = sink + container.size();
+        return size;
+    });
+
+    run("subscript_hit", [&](Clock::duration &elapsed) {
+        Timer timer(elapsed);
+        size_t sum = 0;
+        for (const auto &key: data.hits) {
+            sum += checksum(base[key]);
+        }
+        sink = sink + sum;
+        return size;
+    });
+
+    run("get", [&](Clock::duration &elapsed) {
+        Timer timer(elapsed);
+        size_t sum = 0;
+        const auto &fallback = data.items.front().value;
+        for (size_t i = 0; i < size; ++i) {
+            sum += checksum(base.get(i % 2 ? data.hits[i] : data.misses[i], fallback));
+        }
+        sink = sink + sum;
+        return size;
+    });
+
+    run("contains", [&](Clock::duration &elapsed) {
+        Timer timer(elapsed);
+        size_t sum = 0;
+        for (size_t i = 0; i < size; ++i) {
+            sum += base.contains(i % 2 ? data.hits[i] : data.misses[i]);
+        }
+        sink = sink + sum;
+        return size;
+    });
+}
+
+std::vector<size_t> benchmark_sizes(const size_t max_size) {
+    std::vector<size_t> sizes;
+    for (size_t size = 8; size <= max_size && size <= 2097152; size *= 8) {
+        sizes.push_back(size);
+    }
+    if (sizes.empty() || sizes.back() != max_size) {
+        sizes.push_back(max_size);
+    }
+    return sizes;
+}
+
+template<typename Key, typename Value = Key>
+void run_type(Runner &runner, const std::string &key_name) {
+    for (const auto size: benchmark_sizes(runner.get_options().max_size)) {
+        // All seeds (present and missing) must give distinct keys
+        if (2 * size > max_distinct<Key>()) {
+            break;
+        }
+        const auto data = make_data<Key, Value>(size);
+        run_container<dictcpp::Dict<Key, Value> >(runner, "Dict", key_name, data);
+        run_frozen(runner, key_name, data);
+        run_container<std::unordered_map<Key, Value> >(runner, "unordered_map", key_name, data);
+        run_container<std::map<Key, Value> >(runner, "map", key_name, data);
+    }
+}
+
+/// A `Dict` guarded by a single reader/writer lock, the baseline for `ConcurrentDict`
+template<typename Key, typename Value>
+class LockedDict {
+    mutable std::shared_mutex mutex;
+    dictcpp::Dict<Key, Value> dict;
+
+public:
+    explicit LockedDict(const std::vector<dictcpp::Item<Key, Value>> &items): dict(items) {
+    }
+
+    std::optional<Value> get(const Key &key) const {
+        std::shared_lock lock(mutex);
+        const auto it = dict.find(key);
+        return it != dict.items().end() ? std::optional<Value>((*it).value) : std::nullopt;
+    }
+
+    void insert_or_assign(const Key &key, const Value &value) {
+        std::unique_lock lock(mutex);
+        dict.insert_or_assign(key, value);
+    }
+};
+
+/// Times a read-mostly mix (a write every 16 operations) on each thread count. The time per
+/// operation is the wall time divided by the operations of all threads, so it falls as the
+/// throughput scales.
+template<typename Container, typename Key, typename Value>
+void run_concurrent_container(Runner &runner, const std::string &container_name, const std::string &key_name,
+                              const Data<Key, Value> &data) {
+    const auto size = data.items.size();
+    Container container(data.items);
+    for (size_t threads = 1; threads <= std::max(1u, std::thread::hardware_concurrency()); threads *= 2) {
+        runner.run("read_mostly_" + std::to_string(threads) + "_threads", container_name, key_name, size,
+                   [&](Clock::duration &elapsed) {
+                       Timer timer(elapsed);
+                       std::vector<std::thread> workers;
+                       for (size_t t = 0; t < threads; ++t) {
+                           workers.emplace_back([&, t] {
+                               size_t sum = 0;
+                               for (size_t i = 0; i < size; ++i) {
+                                   const auto &key = data.hits[(i + t * size / threads) % size];
+                                   if (i % 16 == 0) {
+                                       container.insert_or_assign(key, data.items[i].value);
+                                   } else {
+                                       sum += container.get(key).has_value();
+                                   }
+                               }
+                               sink = sink + sum;
+                           });
+                       }
+                       for (auto &worker: workers) {
+                           worker.join();
+                       }
+                       return threads * size;
+                   });
+    }
+}
+
+template<typename Key, typename Value = Key>
+void run_concurrent(Runner &runner, const std::string &key_name) {
+    const auto data = make_data<Key, Value>(std::min<size_t>(runner.get_options().max_size, 65536));
+    run_concurrent_container<dictcpp::ConcurrentDict<Key, Value> >(runner, "ConcurrentDict", key_name, data);
+    run_concurrent_container<LockedDict<Key, Value> >(runner, "LockedDict", key_name, data);
+}
+
+Options parse_options(const int argc, char **argv) {
+    Options options;
+    for (int i = 1; i < argc; i += 2) {
+        const std::string flag = argv[i];
+        if (i + 1 == argc) {
+            throw std::invalid_argument("Missing value for option: " + flag);
+        }
+        const std::string value = argv[i + 1];
+        if (flag == "--max-size") {
+            options.max_size = std::stoull(value);
+        } else if (flag == "--min-time-ms") {
+            options.min_time_ms = std::stod(value);
+        } else if (flag == "--filter") {
+            options.filter = value;
+        } else if (flag == "--output") {
+            options.output = value;
+        } else {
+            throw std::invalid_argument("Unknown option: " + flag);
+        }
+    }
+
+    return options;
+}
+}
+
+int main(const int argc, char **argv) {
+    Runner runner(parse_options(argc, argv));
+
+    run_type<int>(runner, "int");
+    run_type<char>(runner, "char");
+    run_type<std::string>(runner, "string");
+    run_type<LargeStruct>(runner, "large_struct");
+    run_concurrent<int>(runner, "int");
+
+    runner.write_json();
+
+    return 0;
+}
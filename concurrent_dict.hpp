@@ -0,0 +1,554 @@
+#ifndef DICTCPP_CONCURRENT_DICT_HPP
+#define DICTCPP_CONCURRENT_DICT_HPP
+#include "dictcpp.hpp"
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
+#include <shared_mutex>
+
+namespace dictcpp {
+/// A thread-safe dictionary for concurrent reads and writes.
+///
+/// Keys are distributed by hash over a number of shards, each a `Dict` guarded by its own
+/// reader/writer lock, so that threads using different shards do not contend, and any number
+/// of threads can read a shard at once. Every operation on a single key is atomic, including
+/// the compound operations `setdefault()`, `pop()`, `update()` and `compute_if_absent()`.
+///
+/// As no reference into the dictionary can be held safely while other threads modify it, values
+/// are returned by copy, or accessed within a callback (`visit()`, `update()`) while the shard is
+/// locked. The callbacks must not access the same `ConcurrentDict`.
+///
+/// The insertion order of all keys is recorded, so `snapshot()` returns a consistent copy of the
+/// whole dictionary as a `Dict` in insertion order (as Python dictionaries are).
+///
+/// @tparam Key Type of dictionary `keys`
+/// @tparam Value Type of dictionary `values` (default: `Key`)
+/// @tparam Hash Hash function for keys (default: `dictcpp::Hash<Key>`)
+/// @tparam KeyEqual Equality comparison for keys (default: `std::equal_to<>`)
+template<typename Key, typename Value = Key, typename Hash = dictcpp::Hash<Key>, typename KeyEqual = std::equal_to<> >
+class ConcurrentDict {
+    // Values are stored with the position of their key in the insertion order
+    struct Entry {
+        Value value;
+        uint64_t order;
+    };
+
+    // Shards are aligned to separate cache lines, so that locking one does not slow down
+    // access to its neighbours
+    using ShardDict = Dict<Key, Entry, Hash, KeyEqual>;
+
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        ShardDict dict;
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    size_t shard_mask;
+    std::atomic<size_t> count = 0;
+    std::atomic<uint64_t> next_order = 0;
+    [[no_unique_address]] Hash hasher;
+
+    static constexpr size_t npos = ShardDict::npos;
+
+    // Types which can be used to look up keys (as for `Dict`)
+    template<typename K>
+    static constexpr bool is_lookup_key = ShardDict::template is_lookup_key<K>;
+
+    // Keys are hashed once, as the shard dictionary would hash them: the hash chooses the
+    // shard, and is then passed to the dictionary of the shard
+    template<typename K>
+    size_t hash_key(const K &key) const {
+        const size_t hash = hasher(key);
+        return hash == ShardDict::dead_hash ? hash - 1 : hash;
+    }
+
+    // The shard is chosen by the high bits of the hash times an odd constant, which are
+    // independent of the bits used by the index of each shard
+    Shard &shard_for(const size_t hash) const {
+        const auto mixed = static_cast<uint64_t>(hash) * 0xD6E8FEB86659FD93;
+        return shards[static_cast<size_t>(mixed >> 32) & shard_mask];
+    }
+
+    // Position of `key` in the dictionary of its shard, or `npos`
+    template<typename K>
+    static size_t find_in(const Shard &shard, const K &key, const size_t hash) {
+        return shard.dict.locate(key, hash).index;
+    }
+
+    static Value &value_at(Shard &shard, const size_t index) {
+        return shard.dict.val_list[index].value;
+    }
+
+    // Insert a key known to be absent at the `location` found for it, with a value constructed
+    // from `args`. Returns the position of the new entry.
+    template<typename K, typename... Args>
+    size_t insert_in(Shard &shard, const typename ShardDict::Location location, const size_t hash, K &&key,
+                     Args &&... args) {
+        const auto index = shard.dict.insert_at(location.slot, hash, std::forward<K>(key),
+                                                Entry{Value(std::forward<Args>(args)...), 0});
+        shard.dict.val_list[index].order = next_order.fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        return index;
+    }
+
+    // Position of `key` (inserting it with a value constructed from `args` if it is absent),
+    // and whether it was inserted
+    template<typename K, typename... Args>
+    std::pair<size_t, bool> try_emplace_in(Shard &shard, const size_t hash, K &&key, Args &&... args) {
+        const auto location = shard.dict.locate(key, hash);
+        if (location.index != npos) {
+            return {location.index, false};
+        }
+        return {insert_in(shard, location, hash, std::forward<K>(key), std::forward<Args>(args)...), true};
+    }
+
+    template<typename K, typename M>
+    bool insert_or_assign_in(Shard &shard, const size_t hash, K &&key, M &&value) {
+        const auto location = shard.dict.locate(key, hash);
+        if (location.index != npos) {
+            value_at(shard, location.index) = std::forward<M>(value);
+            return false;
+        }
+        insert_in(shard, location, hash, std::forward<K>(key), std::forward<M>(value));
+        return true;
+    }
+
+    // Lock every shard, in order (which cannot deadlock, as no other operation holds more than
+    // one shard lock)
+    template<typename Lock>
+    std::vector<Lock> lock_all() const {
+        std::vector<Lock> locks;
+        locks.reserve(shard_mask + 1);
+        for (size_t i = 0; i <= shard_mask; ++i) {
+            locks.emplace_back(shards[i].mutex);
+        }
+        return locks;
+    }
+
+public:
+    /// Default number of shards: four per hardware thread, so that contention is rare
+    ///
+    /// @return Number of shards
+    static size_t default_shard_count() {
+        return 4 * std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    /// Initialise an empty dictionary
+    ///
+    /// @param shard_count Number of shards, rounded up to a power of two (default: `default_shard_count()`)
+    explicit ConcurrentDict(const size_t shard_count = default_shard_count())
+        : shards(std::make_unique<Shard[]>(std::bit_ceil(std::max<size_t>(shard_count, 1)))),
+          shard_mask(std::bit_ceil(std::max<size_t>(shard_count, 1)) - 1) {
+    }
+
+    /// Initialise a dictionary using a list of `Item`s
+    ///
+    /// @param key_values A list of dictionary `Item`s (key-value pair)
+    /// @param shard_count Number of shards (default: `default_shard_count()`)
+    ConcurrentDict(const std::initializer_list<Item<Key, Value>> &key_values,
+                   const size_t shard_count = default_shard_count()) : ConcurrentDict(shard_count) {
+        for (const auto &[key, value]: key_values) {
+            insert_or_assign(key, value);
+        }
+    }
+
+    /// Initialise a dictionary using a vector of `Item`s
+    ///
+    /// @param key_values A vector of dictionary `Item`s (key-value pair)
+    /// @param shard_count Number of shards (default: `default_shard_count()`)
+    explicit ConcurrentDict(const std::vector<Item<Key, Value>> &key_values,
+                            const size_t shard_count = default_shard_count()) : ConcurrentDict(shard_count) {
+        for (const auto &[key, value]: key_values) {
+            insert_or_assign(key, value);
+        }
+    }
+
+    ConcurrentDict(const ConcurrentDict &) = delete;
+
+    ConcurrentDict &operator=(const ConcurrentDict &) = delete;
+
+    ~ConcurrentDict() = default;
+
+    /// Get the number of shards
+    ///
+    /// @return Number of shards
+    [[nodiscard]] size_t shard_count() const {
+        return shard_mask + 1;
+    }
+
+    /// Get the current size of the dictionary (which may change at any time)
+    ///
+    /// @return Number of keys
+    [[nodiscard]] size_t size() const {
+        return count.load(std::memory_order_relaxed);
+    }
+
+    /// Check if the dictionary is empty
+    ///
+    /// @return Whether the dictionary is empty
+    [[nodiscard]] bool empty() const {
+        return size() == 0;
+    }
+
+    /// Check if the dictionary contains `key`
+    ///
+    /// @param key A possible key
+    ///
+    /// @return Whether key is present
+    bool contains(const Key &key) const {
+        return contains<Key>(key);
+    }
+
+    /// Check if the dictionary contains `key` (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @return Whether key is present
+    template<typename K> requires is_lookup_key<K>
+    bool contains(const K &key) const {
+        const auto hash = hash_key(key);
+        const auto &shard = shard_for(hash);
+        std::shared_lock lock(shard.mutex);
+        return find_in(shard, key, hash) != npos;
+    }
+
+    /// Get a copy of the value at `key`
+    ///
+    /// @param key Dictionary key
+    ///
+    /// @return Value at key, `std::nullopt` if the key is not present
+    std::optional<Value> get(const Key &key) const {
+        return get<Key>(key);
+    }
+
+    /// Get a copy of the value at `key` (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @return Value at key, `std::nullopt` if the key is not present
+    template<typename K> requires is_lookup_key<K>
+    std::optional<Value> get(const K &key) const {
+        const auto hash = hash_key(key);
+        auto &shard = shard_for(hash);
+        std::shared_lock lock(shard.mutex);
+        const auto index = find_in(shard, key, hash);
+        if (index == npos) {
+            return std::nullopt;
+        }
+        return value_at(shard, index);
+    }
+
+    /// Get a copy of the value at `key`, or `default_value` if it is not present
+    ///
+    /// @param key Dictionary key
+    /// @param default_value Value returned if the key is not present
+    ///
+    /// @return Value at key, if present, default value otherwise
+    Value get(const Key &key, const Value &default_value) const {
+        return get<Key>(key, default_value);
+    }
+
+    /// Get a copy of the value at `key`, or `default_value` if it is not present
+    /// (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    /// @param default_value Value returned if the key is not present
+    ///
+    /// @return Value at key, if present, default value otherwise
+    template<typename K> requires is_lookup_key<K>
+    Value get(const K &key, const Value &default_value) const {
+        auto value = get(key);
+        return value ? std::move(*value) : default_value;
+    }
+
+    /// Call `function` with the value at `key` (if present), while other threads cannot modify it
+    ///
+    /// @param key Dictionary key
+    /// @param function Function called with a constant reference to the value
+    ///
+    /// @return Whether the key is present
+    template<typename Function>
+    bool visit(const Key &key, Function &&function) const {
+        return visit<Key, Function>(key, std::forward<Function>(function));
+    }
+
+    /// Call `function` with the value at `key` (if present), while other threads cannot modify it
+    /// (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    /// @param function Function called with a constant reference to the value
+    ///
+    /// @return Whether the key is present
+    template<typename K, typename Function> requires is_lookup_key<K>
+    bool visit(const K &key, Function &&function) const {
+        const auto hash = hash_key(key);
+        auto &shard = shard_for(hash);
+        std::shared_lock lock(shard.mutex);
+        const auto index = find_in(shard, key, hash);
+        if (index == npos) {
+            return false;
+        }
+        std::forward<Function>(function)(std::as_const(value_at(shard, index)));
+        return true;
+    }
+
+    /// Assign `value` to `key`, inserting the key if it is not present
+    ///
+    /// @param key Dictionary key
+    /// @param value Value to assign
+    ///
+    /// @return Whether the key was inserted
+    template<typename M>
+    bool insert_or_assign(const Key &key, M &&value) {
+        const auto hash = hash_key(key);
+        auto &shard = shard_for(hash);
+        std::unique_lock lock(shard.mutex);
+        return insert_or_assign_in(shard, hash, key, std::forward<M>(value));
+    }
+
+    /// Assign `value` to `key` (moving the key if it is inserted)
+    ///
+    /// @param key Dictionary key
+    /// @param value Value to assign
+    ///
+    /// @return Whether the key was inserted
+    template<typename M>
+    bool insert_or_assign(Key &&key, M &&value) {
+        const auto hash = hash_key(key);
+        auto &shard = shard_for(hash);
+        std::unique_lock lock(shard.mutex);
+        return insert_or_assign_in(shard, hash, std::move(key), std::forward<M>(value));
+    }
+
+    /// Insert `key` with a value constructed from `args`, if the key is not present
+    ///
+    /// @param key Dictionary key
+    /// @param args Arguments for the constructor of `Value`
+    ///
+    /// @return Whether the key was inserted
+    template<typename... Args>
+    bool try_emplace(const Key &key, Args &&... args) {
+        const auto hash = hash_key(key);
+        auto &shard = shard_for(hash);
+        std::unique_lock lock(shard.mutex);
+        return try_emplace_in(shard, hash, key, std::forward<Args>(args)...).second;
+    }
+
+    /// If `key` is present, return its value. Otherwise, insert `key` with `default_value` and
+    /// return it.
+    ///
+    /// @param key Dictionary key
+    /// @param default_value Value inserted if the key is not present (default: `Value()`)
+    ///
+    /// @return Value at key
+    Value setdefault(const Key &key, Value default_value = Value()) {
+        const auto hash = hash_key(key);
+        auto &shard = shard_for(hash);
+        std::unique_lock lock(shard.mutex);
+        return value_at(shard, try_emplace_in(shard, hash, key, std::move(default_value)).first);
+    }
+
+    /// If `key` is not present, insert it with the value returned by `factory()`. The factory is
+    /// only called if the key is absent, and at most once for each key.
+    ///
+    /// @param key Dictionary key
+    /// @param factory Function returning the value for a new key
+    ///
+    /// @return Value at key
+    template<typename Factory>
+    Value compute_if_absent(const Key &key, Factory &&factory) {
+        const auto hash = hash_key(key);
+        auto &shard = shard_for(hash);
+        {
+            std::shared_lock lock(shard.mutex);
+            if (const auto index = find_in(shard, key, hash); index != npos) {
+                return value_at(shard, index);
+            }
+        }
+
+        // Another thread may have inserted the key between the two locks
+        std::unique_lock lock(shard.mutex);
+        const auto location = shard.dict.locate(key, hash);
+        if (location.index != npos) {
+            return value_at(shard, location.index);
+        }
+        return value_at(shard, insert_in(shard, location, hash, key, std::forward<Factory>(factory)()));
+    }
+
+    /// Modify the value at `key` (if present) by calling `function`, while no other thread can
+    /// access it
+    ///
+    /// @param key Dictionary key
+    /// @param function Function called with a reference to the value
+    ///
+    /// @return Whether the key is present
+    template<typename Function>
+    bool update(const Key &key, Function &&function) {
+        return update<Key, Function>(key, std::forward<Function>(function));
+    }
+
+    /// Modify the value at `key` (if present) by calling `function`, while no other thread can
+    /// access it (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    /// @param function Function called with a reference to the value
+    ///
+    /// @return Whether the key is present
+    template<typename K, typename Function> requires is_lookup_key<K>
+    bool update(const K &key, Function &&function) {
+        const auto hash = hash_key(key);
+        auto &shard = shard_for(hash);
+        std::unique_lock lock(shard.mutex);
+        const auto index = find_in(shard, key, hash);
+        if (index == npos) {
+            return false;
+        }
+        std::forward<Function>(function)(value_at(shard, index));
+        return true;
+    }
+
+    /// Modify the value at `key` by calling `function`, first inserting `key` with
+    /// `default_value` if it is not present. For example, `upsert(word, [](int &n) { n++; })`
+    /// counts words.
+    ///
+    /// @param key Dictionary key
+    /// @param function Function called with a reference to the value
+    /// @param default_value Value inserted if the key is not present (default: `Value()`)
+    ///
+    /// @return Value at key after the modification
+    template<typename Function>
+    Value upsert(const Key &key, Function &&function, Value default_value = Value()) {
+        const auto hash = hash_key(key);
+        auto &shard = shard_for(hash);
+        std::unique_lock lock(shard.mutex);
+        auto &value = value_at(shard, try_emplace_in(shard, hash, key, std::move(default_value)).first);
+        std::forward<Function>(function)(value);
+        return value;
+    }
+
+    /// Updates the dictionary with the key/value pairs of a `Dict` (each one atomically)
+    ///
+    /// @param other Dictionary
+    template<size_t InlineCapacity, typename Allocator>
+    void update(const Dict<Key, Value, Hash, KeyEqual, InlineCapacity, Allocator> &other) {
+        for (const auto &item: other.items()) {
+            insert_or_assign(item.key, item.value);
+        }
+    }
+
+    /// Remove `key` from the dictionary and return its value
+    ///
+    /// @param key Dictionary key
+    ///
+    /// @return Value at key, `std::nullopt` if the key is not present
+    std::optional<Value> pop(const Key &key) {
+        return pop<Key>(key);
+    }
+
+    /// Remove `key` from the dictionary and return its value (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @return Value at key, `std::nullopt` if the key is not present
+    template<typename K> requires is_lookup_key<K>
+    std::optional<Value> pop(const K &key) {
+        const auto hash = hash_key(key);
+        auto &shard = shard_for(hash);
+        std::unique_lock lock(shard.mutex);
+        const auto location = shard.dict.locate(key, hash);
+        if (location.index == npos) {
+            return std::nullopt;
+        }
+        std::optional<Value> value(std::move(value_at(shard, location.index)));
+        shard.dict.erase_at(location);
+        count.fetch_sub(1, std::memory_order_relaxed);
+        return value;
+    }
+
+    /// Remove `key` from the dictionary and return its value, or return `default_value` if it
+    /// is not present
+    ///
+    /// @param key Dictionary key
+    /// @param default_value Value returned if the key is not present
+    ///
+    /// @return Value at key in dictionary if it exists, otherwise the default
+    Value pop(const Key &key, Value default_value) {
+        return pop<Key>(key, std::move(default_value));
+    }
+
+    /// Remove `key` from the dictionary and return its value, or return `default_value` if it
+    /// is not present (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    /// @param default_value Value returned if the key is not present
+    ///
+    /// @return Value at key in dictionary if it exists, otherwise the default
+    template<typename K> requires is_lookup_key<K>
+    Value pop(const K &key, Value default_value) {
+        auto value = pop(key);
+        return value ? std::move(*value) : std::move(default_value);
+    }
+
+    /// Remove `key` from the dictionary
+    ///
+    /// @param key Dictionary key
+    ///
+    /// @throws std::out_of_range If key not in dictionary
+    void del(const Key &key) {
+        del<Key>(key);
+    }
+
+    /// Remove `key` from the dictionary (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @throws std::out_of_range If key not in dictionary
+    template<typename K> requires is_lookup_key<K>
+    void del(const K &key) {
+        if (!pop(key)) {
+            throw std::out_of_range("Key not found in dictionary");
+        }
+    }
+
+    /// Remove all items from the dictionary
+    void clear() {
+        const auto locks = lock_all<std::unique_lock<std::shared_mutex> >();
+        for (size_t i = 0; i <= shard_mask; ++i) {
+            shards[i].dict.clear();
+        }
+        count.store(0, std::memory_order_relaxed);
+    }
+
+    /// Copy the dictionary, as at a single point in time, into a `Dict` in insertion order
+    ///
+    /// @return Copy of the dictionary
+    Dict<Key, Value, Hash, KeyEqual> snapshot() const {
+        std::vector<std::pair<uint64_t, Item<Key, Value> > > items;
+        {
+            const auto locks = lock_all<std::shared_lock<std::shared_mutex> >();
+            for (size_t i = 0; i <= shard_mask; ++i) {
+                for (const auto &item: shards[i].dict.items()) {
+                    items.push_back({item.value.order, {item.key, item.value.value}});
+                }
+            }
+        }
+        std::ranges::sort(items, {}, [](const auto &item) { return item.first; });
+
+        Dict<Key, Value, Hash, KeyEqual> dict;
+        dict.reserve(items.size());
+        for (auto &[order, item]: items) {
+            dict.try_emplace(std::move(item.key), std::move(item.value));
+        }
+        return dict;
+    }
+};
+}
+
+#endif //DICTCPP_CONCURRENT_DICT_HPP
@@ -0,0 +1,613 @@
+#ifndef DICTCPP_DICT_LOADER_HPP
+#define DICTCPP_DICT_LOADER_HPP
+#include "dictcpp.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <utility>
+#include <charconv>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <filesystem>
+#include <string_view>
+#include <type_traits>
+
+namespace dictcpp {
+/// Conversion of the text of fields read by the loaders to keys and values. Strings are copied,
+/// arithmetic types are parsed with `std::from_chars`, and `bool` accepts `true`, `false`, `1`
+/// and `0`. Specialise `Parser` to support other types.
+///
+/// @tparam T Type of keys or values
+template<typename T>
+struct Parser {
+    static T parse(const std::string_view text) {
+        if constexpr (std::is_same_v<T, bool>) {
+            if (text == "true" || text == "1") {
+                return true;
+            }
+            if (text == "false" || text == "0") {
+                return false;
+            }
+            throw std::runtime_error("Invalid boolean: " + std::string(text));
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            T value{};
+            const auto *end = text.data() + text.size();
+            if (const auto [last, error] = std::from_chars(text.data(), end, value); error != std::errc() || last != end) {
+                throw std::runtime_error("Invalid number: " + std::string(text));
+            }
+            return value;
+        } else {
+            static_assert(std::is_constructible_v<T, std::string_view>, "Specialise dictcpp::Parser for this type");
+            return T(text);
+        }
+    }
+};
+
+/// Options of the loaders
+struct LoadOptions {
+    /// Number of bytes read from the input at a time by each thread. A record longer than this
+    /// is read whole.
+    size_t chunk_size = 1 << 20;
+    /// Number of threads parsing chunks. JSON is always parsed by one thread.
+    size_t threads = 1;
+    /// Number of items expected, so that the dictionary is allocated once
+    size_t expected_size = 0;
+    /// Separator of the fields of CSV
+    char delimiter = ',';
+    /// Whether the first record of CSV is a header, which is skipped
+    bool header = false;
+};
+
+namespace detail {
+// Reads a stream in chunks which end after the last whole record in them
+class ChunkReader {
+    std::istream &in;
+    std::string pending;
+    size_t chunk_size;
+
+public:
+    ChunkReader(std::istream &in, const size_t chunk_size): in(in), chunk_size(std::max<size_t>(chunk_size, 1)) {
+    }
+
+    // `record_end(chunk)` is the position after the last whole record, or 0 if there is none.
+    // Empty at the end of the stream.
+    template<typename RecordEnd>
+    std::string next(RecordEnd record_end) {
+        auto chunk = std::exchange(pending, {});
+        while (true) {
+            const auto size = chunk.size();
+            chunk.resize(size + chunk_size);
+            in.read(chunk.data() + size, static_cast<std::streamsize>(chunk_size));
+            chunk.resize(size + static_cast<size_t>(in.gcount()));
+            if (in.bad()) {
+                throw std::runtime_error("Failed to read input");
+            }
+            if (chunk.size() == size) {
+                return chunk;
+            }
+            if (const auto end = record_end(std::string_view(chunk)); end != 0) {
+                pending.assign(chunk, end);
+                chunk.resize(end);
+                return chunk;
+            }
+        }
+    }
+};
+
+inline std::string_view trim(std::string_view text) {
+    constexpr std::string_view space = " \t\r";
+    const auto first = text.find_first_not_of(space);
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    return text.substr(first, text.find_last_not_of(space) - first + 1);
+}
+
+inline size_t lines_end(const std::string_view chunk) {
+    return chunk.rfind('\n') + 1;
+}
+
+// Newlines in quoted fields do not end records. As in `csv_field`, a quote only opens a quoted
+// field at the start of a field, and a doubled quote in a quoted field stands for a quote.
+inline size_t csv_end(const std::string_view chunk, const char delimiter) {
+    size_t end = 0;
+    bool quoted = false;
+    bool field_start = true;
+    for (size_t i = 0; i < chunk.size(); ++i) {
+        const auto c = chunk[i];
+        if (quoted) {
+            if (c == '"') {
+                if (i + 1 < chunk.size() && chunk[i + 1] == '"') {
+                    ++i;
+                } else {
+                    quoted = false;
+                }
+            }
+        } else if (c == '"' && field_start) {
+            quoted = true;
+            field_start = false;
+        } else {
+            if (c == '\n') {
+                end = i + 1;
+            }
+            field_start = c == '\n' || c == delimiter;
+        }
+    }
+    return end;
+}
+
+template<typename Key, typename Value>
+void parse_key_values(const std::string_view chunk, std::vector<std::pair<Key, Value> > &items, bool) {
+    for (size_t first = 0; first < chunk.size();) {
+        const auto last = std::min(chunk.find('\n', first), chunk.size());
+        const auto line = trim(chunk.substr(first, last - first));
+        first = last + 1;
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+        const auto separator = line.find('=');
+        if (separator == std::string_view::npos) {
+            throw std::runtime_error("Invalid line: " + std::string(line));
+        }
+        items.emplace_back(Parser<Key>::parse(trim(line.substr(0, separator))),
+                           Parser<Value>::parse(trim(line.substr(separator + 1))));
+    }
+}
+
+// Parses a CSV field starting at `position`, which is left at the character after it
+inline std::string_view csv_field(const std::string_view chunk, size_t &position, const char delimiter, std::string &buffer) {
+    if (position < chunk.size() && chunk[position] == '"') {
+        buffer.clear();
+        for (++position;; ++position) {
+            if (position == chunk.size()) {
+                throw std::runtime_error("Unterminated quoted field");
+            }
+            if (chunk[position] == '"') {
+                if (position + 1 == chunk.size() || chunk[position + 1] != '"') {
+                    ++position;
+                    return buffer;
+                }
+                ++position;
+            }
+            buffer.push_back(chunk[position]);
+        }
+    }
+    const auto first = position;
+    while (position < chunk.size() && chunk[position] != delimiter && chunk[position] != '\n') {
+        ++position;
+    }
+    auto field = chunk.substr(first, position - first);
+    if (!field.empty() && field.back() == '\r') {
+        field.remove_suffix(1);
+    }
+    return field;
+}
+
+template<typename Key, typename Value>
+void parse_csv(const std::string_view chunk, std::vector<std::pair<Key, Value> > &items, const char delimiter,
+               bool skip_header) {
+    std::string key_buffer, value_buffer;
+    for (size_t position = 0; position < chunk.size();) {
+        if (chunk[position] == '\n' || chunk.substr(position, 2) == "\r\n") {
+            position += chunk[position] == '\n' ? 1 : 2;
+            continue;
+        }
+        const auto key = csv_field(chunk, position, delimiter, key_buffer);
+        if (position == chunk.size() || chunk[position] != delimiter) {
+            throw std::runtime_error("Expected two fields in record: " + std::string(key));
+        }
+        ++position;
+        const auto value = csv_field(chunk, position, delimiter, value_buffer);
+        if (position < chunk.size() && chunk[position] == '\r') {
+            ++position;
+        }
+        if (position < chunk.size() && chunk[position] != '\n') {
+            throw std::runtime_error("Expected two fields in record: " + std::string(key));
+        }
+        ++position;
+        if (std::exchange(skip_header, false)) {
+            continue;
+        }
+        items.emplace_back(Parser<Key>::parse(key), Parser<Value>::parse(value));
+    }
+}
+
+// Parses chunks on up to `options.threads` threads at a time, then inserts their items in the
+// order of the input, so that each key keeps the position where it was first seen
+template<typename Key, typename Value, typename DictType, typename RecordEnd, typename Parse>
+size_t load_chunks(std::istream &in, DictType &dict, const LoadOptions &options, RecordEnd record_end, Parse parse) {
+    const auto threads = std::max<size_t>(options.threads, 1);
+    std::vector<std::string> chunks(threads);
+    std::vector<std::vector<std::pair<Key, Value> > > items(threads);
+    std::vector<std::exception_ptr> errors(threads);
+
+    ChunkReader reader(in, options.chunk_size);
+    size_t count = 0;
+    bool first = true;
+    for (size_t n = threads; n == threads;) {
+        for (n = 0; n < threads; ++n) {
+            chunks[n] = reader.next(record_end);
+            if (chunks[n].empty()) {
+                break;
+            }
+        }
+
+        const auto work = [&](const size_t i) {
+            try {
+                items[i].clear();
+                parse(std::string_view(chunks[i]), items[i], first && i == 0);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        };
+        {
+            std::vector<std::jthread> workers;
+            for (size_t i = 1; i < n; ++i) {
+                workers.emplace_back(work, i);
+            }
+            if (n != 0) {
+                work(0);
+            }
+        }
+        first = false;
+
+        for (size_t i = 0; i < n; ++i) {
+            if (errors[i]) {
+                std::rethrow_exception(errors[i]);
+            }
+            for (auto &[key, value]: items[i]) {
+                dict.insert_or_assign(std::move(key), std::move(value));
+            }
+            count += items[i].size();
+        }
+    }
+    return count;
+}
+
+// Reads JSON from a stream through a buffer of a fixed size
+class JsonReader {
+    std::istream &in;
+    std::vector<char> buffer;
+    size_t position = 0;
+    size_t end = 0;
+
+    bool fill() {
+        in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        if (in.bad()) {
+            throw std::runtime_error("Failed to read input");
+        }
+        position = 0;
+        end = static_cast<size_t>(in.gcount());
+        return end != 0;
+    }
+
+    static void append_utf8(std::string &out, const uint32_t code) {
+        if (code < 0x80) {
+            out.push_back(static_cast<char>(code));
+        } else if (code < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | code >> 6));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        } else if (code < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | code >> 12));
+            out.push_back(static_cast<char>(0x80 | (code >> 6 & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | code >> 18));
+            out.push_back(static_cast<char>(0x80 | (code >> 12 & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (code >> 6 & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+    }
+
+    uint32_t hex4() {
+        uint32_t code = 0;
+        for (int i = 0; i < 4; ++i) {
+            const auto c = next();
+            uint32_t digit;
+            if (c >= '0' && c <= '9') {
+                digit = static_cast<uint32_t>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                digit = static_cast<uint32_t>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                digit = static_cast<uint32_t>(c - 'A' + 10);
+            } else {
+                throw std::runtime_error("Invalid JSON: bad \\u escape");
+            }
+            code = code << 4 | digit;
+        }
+        return code;
+    }
+
+public:
+    static constexpr int eof = std::char_traits<char>::eof();
+
+    JsonReader(std::istream &in, const size_t buffer_size): in(in), buffer(std::max<size_t>(buffer_size, 1)) {
+    }
+
+    int peek() {
+        if (position == end && !fill()) {
+            return eof;
+        }
+        return std::char_traits<char>::to_int_type(buffer[position]);
+    }
+
+    int get() {
+        const auto c = peek();
+        if (c != eof) {
+            ++position;
+        }
+        return c;
+    }
+
+    // The next character, which must exist
+    int next() {
+        const auto c = get();
+        if (c == eof) {
+            throw std::runtime_error("Invalid JSON: unexpected end of input");
+        }
+        return c;
+    }
+
+    void skip_space() {
+        for (auto c = peek(); c == ' ' || c == '\t' || c == '\n' || c == '\r'; c = peek()) {
+            ++position;
+        }
+    }
+
+    void expect(const char expected) {
+        skip_space();
+        if (get() != expected) {
+            throw std::runtime_error(std::string("Invalid JSON: expected '") + expected + "'");
+        }
+    }
+
+    // Reads the rest of a string after its opening quote, unescaped
+    void read_string(std::string &out) {
+        out.clear();
+        for (auto c = next(); c != '"'; c = next()) {
+            if (c != '\\') {
+                out.push_back(static_cast<char>(c));
+                continue;
+            }
+            switch (c = next()) {
+                case '"':
+                case '\\':
+                case '/': out.push_back(static_cast<char>(c)); break;
+                case 'b': out.push_back('\b'); break;
+                case 'f': out.push_back('\f'); break;
+                case 'n': out.push_back('\n'); break;
+                case 'r': out.push_back('\r'); break;
+                case 't': out.push_back('\t'); break;
+                case 'u': {
+                    auto code = hex4();
+                    if (code >= 0xDC00 && code < 0xE000) {
+                        throw std::runtime_error("Invalid JSON: unpaired surrogate");
+                    }
+                    if (code >= 0xD800 && code < 0xDC00) {
+                        if (next() != '\\' || next() != 'u') {
+                            throw std::runtime_error("Invalid JSON: unpaired surrogate");
+                        }
+                        const auto low = hex4();
+                        if (low < 0xDC00 || low >= 0xE000) {
+                            throw std::runtime_error("Invalid JSON: unpaired surrogate");
+                        }
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    append_utf8(out, code);
+                    break;
+                }
+                default: throw std::runtime_error(std::string("Invalid JSON: invalid escape '\\") + static_cast<char>(c) + "'");
+            }
+        }
+    }
+
+    // Reads a value: strings unescaped, numbers and literals as written, and objects and arrays
+    // as their JSON text
+    void read_value(std::string &out) {
+        skip_space();
+        const auto c = peek();
+        if (c == '"') {
+            ++position;
+            read_string(out);
+            return;
+        }
+        out.clear();
+        if (c == '{' || c == '[') {
+            size_t depth = 0;
+            bool quoted = false;
+            do {
+                const auto d = next();
+                out.push_back(static_cast<char>(d));
+                if (quoted) {
+                    if (d == '\\') {
+                        out.push_back(static_cast<char>(next()));
+                    } else if (d == '"') {
+                        quoted = false;
+                    }
+                } else if (d == '"') {
+                    quoted = true;
+                } else if (d == '{' || d == '[') {
+                    ++depth;
+                } else if (d == '}' || d == ']') {
+                    --depth;
+                }
+            } while (depth != 0);
+            return;
+        }
+        for (auto d = peek(); d != eof && d != ',' && d != '}' && d != ']' && d != ' ' && d != '\t' && d != '\n' &&
+                              d != '\r'; d = peek()) {
+            out.push_back(static_cast<char>(d));
+            ++position;
+        }
+        if (out.empty()) {
+            throw std::runtime_error("Invalid JSON: expected a value");
+        }
+    }
+};
+
+inline std::ifstream open_input(const std::filesystem::path &path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Failed to open " + path.string());
+    }
+    return in;
+}
+}
+
+/// Insert the items of `key=value` lines into a dictionary, reading the input in chunks rather
+/// than all at once. Whitespace around keys and values, empty lines and lines starting with `#`
+/// are ignored. A key which is repeated keeps its first position and its last value.
+///
+/// @tparam Key Dictionary key type, converted by `Parser<Key>`
+/// @tparam Value Dictionary value type, converted by `Parser<Value>`
+/// @tparam Hash Dictionary hash function
+/// @tparam KeyEqual Dictionary key comparison
+/// @tparam InlineCapacity Number of items stored inline
+/// @tparam Allocator Dictionary allocator
+/// @param in Input stream
+/// @param dict Dictionary
+/// @param options Chunk size, number of threads and expected number of items
+///
+/// @throws std::runtime_error If a line has no `=`, a key or value cannot be converted, or reading fails.
+/// Items before the error may have been inserted.
+///
+/// @return Number of items read
+template<typename Key, typename Value, typename Hash, typename KeyEqual, size_t InlineCapacity, typename Allocator>
+size_t load_key_values(std::istream &in, Dict<Key, Value, Hash, KeyEqual, InlineCapacity, Allocator> &dict,
+                       const LoadOptions &options = {}) {
+    dict.reserve(dict.size() + options.expected_size);
+    return detail::load_chunks<Key, Value>(in, dict, options, detail::lines_end, detail::parse_key_values<Key, Value>);
+}
+
+/// Insert the items of `key=value` lines in a file into a dictionary
+///
+/// @see load_key_values(std::istream &, Dict &, const LoadOptions &)
+///
+/// @throws std::runtime_error If the file cannot be opened, or as `load_key_values()`
+template<typename Key, typename Value, typename Hash, typename KeyEqual, size_t InlineCapacity, typename Allocator>
+size_t load_key_values(const std::filesystem::path &path, Dict<Key, Value, Hash, KeyEqual, InlineCapacity, Allocator> &dict,
+                       const LoadOptions &options = {}) {
+    auto in = detail::open_input(path);
+    return load_key_values(in, dict, options);
+}
+
+/// Insert the items of two-column CSV records into a dictionary, reading the input in chunks
+/// rather than all at once. Fields may be quoted, with `""` for a quote, and quoted fields may
+/// contain delimiters and newlines. A key which is repeated keeps its first position and its last
+/// value.
+///
+/// @tparam Key Dictionary key type, converted by `Parser<Key>`
+/// @tparam Value Dictionary value type, converted by `Parser<Value>`
+/// @tparam Hash Dictionary hash function
+/// @tparam KeyEqual Dictionary key comparison
+/// @tparam InlineCapacity Number of items stored inline
+/// @tparam Allocator Dictionary allocator
+/// @param in Input stream
+/// @param dict Dictionary
+/// @param options Chunk size, number of threads, expected number of items, delimiter and header
+///
+/// @throws std::runtime_error If a record does not have two fields, a key or value cannot be
+/// converted, or reading fails. Items before the error may have been inserted.
+///
+/// @return Number of items read, excluding the header
+template<typename Key, typename Value, typename Hash, typename KeyEqual, size_t InlineCapacity, typename Allocator>
+size_t load_csv(std::istream &in, Dict<Key, Value, Hash, KeyEqual, InlineCapacity, Allocator> &dict,
+                const LoadOptions &options = {}) {
+    dict.reserve(dict.size() + options.expected_size);
+    const auto parse = [&](const std::string_view chunk, std::vector<std::pair<Key, Value> > &items, const bool first) {
+        detail::parse_csv(chunk, items, options.delimiter, first && options.header);
+    };
+    const auto record_end = [&](const std::string_view chunk) {
+        return detail::csv_end(chunk, options.delimiter);
+    };
+    return detail::load_chunks<Key, Value>(in, dict, options, record_end, parse);
+}
+
+/// Insert the items of two-column CSV records in a file into a dictionary
+///
+/// @see load_csv(std::istream &, Dict &, const LoadOptions &)
+///
+/// @throws std::runtime_error If the file cannot be opened, or as `load_csv()`
+template<typename Key, typename Value, typename Hash, typename KeyEqual, size_t InlineCapacity, typename Allocator>
+size_t load_csv(const std::filesystem::path &path, Dict<Key, Value, Hash, KeyEqual, InlineCapacity, Allocator> &dict,
+                const LoadOptions &options = {}) {
+    auto in = detail::open_input(path);
+    return load_csv(in, dict, options);
+}
+
+/// Insert the members of a JSON object into a dictionary, reading the input through a buffer of
+/// `options.chunk_size` bytes rather than all at once. Values which are strings are unescaped;
+/// other values are converted from their JSON text, so objects and arrays can be read as strings.
+/// A key which is repeated keeps its first position and its last value.
+///
+/// @tparam Key Dictionary key type, converted by `Parser<Key>`
+/// @tparam Value Dictionary value type, converted by `Parser<Value>`
+/// @tparam Hash Dictionary hash function
+/// @tparam KeyEqual Dictionary key comparison
+/// @tparam InlineCapacity Number of items stored inline
+/// @tparam Allocator Dictionary allocator
+/// @param in Input stream
+/// @param dict Dictionary
+/// @param options Buffer size and expected number of items
+///
+/// @throws std::runtime_error If the input is not a JSON object, a key or value cannot be
+/// converted, or reading fails. Items before the error may have been inserted.
+///
+/// @return Number of items read
+template<typename Key, typename Value, typename Hash, typename KeyEqual, size_t InlineCapacity, typename Allocator>
+size_t load_json(std::istream &in, Dict<Key, Value, Hash, KeyEqual, InlineCapacity, Allocator> &dict,
+                 const LoadOptions &options = {}) {
+    dict.reserve(dict.size() + options.expected_size);
+    detail::JsonReader reader(in, options.chunk_size);
+    std::string key, value;
+    size_t count = 0;
+
+    reader.expect('{');
+    reader.skip_space();
+    if (reader.peek() == '}') {
+        reader.get();
+    } else {
+        while (true) {
+            reader.expect('"');
+            reader.read_string(key);
+            reader.expect(':');
+            reader.read_value(value);
+            dict.insert_or_assign(Parser<Key>::parse(key), Parser<Value>::parse(value));
+            ++count;
+
+            reader.skip_space();
+            const auto c = reader.get();
+            if (c == '}') {
+                break;
+            }
+            if (c != ',') {
+                throw std::runtime_error("Invalid JSON: expected ',' or '}'");
+            }
+        }
+    }
+    reader.skip_space();
+    if (reader.peek() != detail::JsonReader::eof) {
+        throw std::runtime_error("Invalid JSON: unexpected data after the object");
+    }
+    return count;
+}
+
+/// Insert the members of a JSON object in a file into a dictionary
+///
+/// @see load_json(std::istream &, Dict &, const LoadOptions &)
+///
+/// @throws std::runtime_error If the file cannot be opened, or as `load_json()`
+template<typename Key, typename Value, typename Hash, typename KeyEqual, size_t InlineCapacity, typename Allocator>
+size_t load_json(const std::filesystem::path &path, Dict<Key, Value, Hash, KeyEqual, InlineCapacity, Allocator> &dict,
+                 const LoadOptions &options = {}) {
+    auto in = detail::open_input(path);
+    return load_json(in, dict, options);
+}
+}
+
+#endif //DICTCPP_DICT_LOADER_HPP
@@ -0,0 +1,262 @@
+#ifndef DICTCPP_DICT_RANGES_HPP
+#define DICTCPP_DICT_RANGES_HPP
+#include "dictcpp.hpp"
+
+#include <ranges>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <type_traits>
+#include <initializer_list>
+
+namespace dictcpp {
+/// A lazy view of the items of a dictionary (or of any range of key-value pairs) transformed by
+/// `filter_items()`, `map_values()`, `map_keys()` or `select_keys()`. Items are computed as the
+/// view is iterated, in the order of the source, without any intermediate dictionary. The view
+/// carries an upper bound of its size, so that `to_dict()` (or constructing or updating a `Dict`
+/// with it) allocates the storage of the result once.
+///
+/// @tparam V Underlying view of the items
+template<std::ranges::view V>
+class ItemPipeline : public std::ranges::view_interface<ItemPipeline<V> > {
+    V view;
+    size_t bound = 0;
+
+public:
+    ItemPipeline() requires std::default_initializable<V> = default;
+
+    constexpr ItemPipeline(V view, const size_t bound): view(std::move(view)), bound(bound) {
+    }
+
+    constexpr auto begin() {
+        return std::ranges::begin(view);
+    }
+
+    constexpr auto end() {
+        return std::ranges::end(view);
+    }
+
+    constexpr auto begin() const requires std::ranges::range<const V> {
+        return std::ranges::begin(view);
+    }
+
+    constexpr auto end() const requires std::ranges::range<const V> {
+        return std::ranges::end(view);
+    }
+
+    /// @return The largest number of items the view can produce (exact unless the items are
+    /// filtered)
+    [[nodiscard]] constexpr size_t size_hint() const {
+        return bound;
+    }
+};
+
+namespace detail {
+// Sources of pipelines: dictionaries (by reference, since their items view refers to them) and
+// any other viewable range of key-value pairs
+template<typename R>
+concept PipelineSource = (requires(R &range) { range.items(); } && std::is_lvalue_reference_v<R>)
+                         || (!requires(R &range) { range.items(); } && ItemRange<R> && std::ranges::viewable_range<R>);
+
+template<typename R>
+constexpr auto items_of(R &&range) {
+    if constexpr (requires { range.items(); }) {
+        return range.items();
+    } else {
+        return std::views::all(std::forward<R>(range));
+    }
+}
+
+// Upper bound of the number of items of a source
+template<typename R>
+constexpr size_t size_bound(R &range) {
+    if constexpr (requires { { range.size_hint() } -> std::convertible_to<size_t>; }) {
+        return range.size_hint();
+    } else if constexpr (std::ranges::sized_range<R>) {
+        return static_cast<size_t>(std::ranges::size(range));
+    } else {
+        return 0;
+    }
+}
+
+// Type in which a pipeline stores a key or value: references into the source are kept, but
+// anything owned by a temporary item is moved out of it
+template<typename T>
+using stored_t = std::conditional_t<std::is_rvalue_reference_v<T>, std::remove_cvref_t<T>, T>;
+
+template<typename T>
+using pair_key_t = stored_t<decltype(pair_key(std::declval<T>()))>;
+
+template<typename T>
+using pair_value_t = stored_t<decltype(pair_value(std::declval<T>()))>;
+
+// Type of the keys or values of the dictionary materialised from a pipeline by default (the
+// values of a `Dict` of `bool`s are referenced by proxies)
+template<typename T>
+using materialised_t = std::conditional_t<std::is_same_v<std::remove_cvref_t<T>, BitReference>, bool, std::remove_cvref_t<T> >;
+
+template<typename Predicate>
+struct FilterItems {
+    Predicate predicate;
+};
+
+template<typename Function>
+struct MapValues {
+    Function function;
+};
+
+template<typename Function>
+struct MapKeys {
+    Function function;
+};
+
+template<typename Keys>
+struct SelectKeys {
+    Keys keys;
+};
+
+template<typename DictType>
+struct ToDict {
+};
+}
+
+/// Keep only the items for which `predicate(key, value)` is true
+///
+/// @param predicate Function of a key and its value
+///
+/// @return Adaptor applied to a dictionary or a pipeline with `|`
+template<typename Predicate>
+constexpr detail::FilterItems<Predicate> filter_items(Predicate predicate) {
+    return {std::move(predicate)};
+}
+
+/// Replace the value of each item with `function(value)`
+///
+/// @param function Function of a value
+///
+/// @return Adaptor applied to a dictionary or a pipeline with `|`
+template<typename Function>
+constexpr detail::MapValues<Function> map_values(Function function) {
+    return {std::move(function)};
+}
+
+/// Replace the key of each item with `function(key)`. If several items map to the same key,
+/// the last one wins when the pipeline is materialised (as in `Dict::update()`).
+///
+/// @param function Function of a key
+///
+/// @return Adaptor applied to a dictionary or a pipeline with `|`
+template<typename Function>
+constexpr detail::MapKeys<Function> map_keys(Function function) {
+    return {std::move(function)};
+}
+
+/// Select the items of a dictionary with the given keys, in the order of `keys`. Keys which are
+/// not in the dictionary are skipped.
+///
+/// @param keys Range of keys (kept by reference if it is an lvalue)
+///
+/// @return Adaptor applied to a dictionary with `|`
+template<std::ranges::viewable_range R> requires std::ranges::input_range<R>
+constexpr detail::SelectKeys<std::views::all_t<R> > select_keys(R &&keys) {
+    return {std::views::all(std::forward<R>(keys))};
+}
+
+/// Select the items of a dictionary with the given keys, in the order of `keys`
+///
+/// @param keys List of keys
+///
+/// @return Adaptor applied to a dictionary with `|`
+template<typename K>
+detail::SelectKeys<std::views::all_t<std::vector<K> > > select_keys(std::initializer_list<K> keys) {
+    return {std::views::all(std::vector<K>(keys))};
+}
+
+namespace detail {
+// The adaptors are applied by these operators, found by argument-dependent lookup
+template<typename R, typename Predicate> requires PipelineSource<R>
+constexpr auto operator|(R &&range, FilterItems<Predicate> filter) {
+    const size_t bound = size_bound(range);
+    auto keep = [predicate = std::move(filter.predicate)](const auto &item) {
+        return static_cast<bool>(std::invoke(predicate, pair_key(item), pair_value(item)));
+    };
+    return ItemPipeline(items_of(std::forward<R>(range)) | std::views::filter(std::move(keep)), bound);
+}
+
+template<typename R, typename Function> requires PipelineSource<R>
+constexpr auto operator|(R &&range, MapValues<Function> map) {
+    const size_t bound = size_bound(range);
+    auto apply = [function = std::move(map.function)]<typename T>(T &&item) {
+        using Result = stored_t<decltype(std::invoke(function, pair_value(std::forward<T>(item))))>;
+        return Item<pair_key_t<T>, Result>{
+            pair_key(std::forward<T>(item)), std::invoke(function, pair_value(std::forward<T>(item)))
+        };
+    };
+    return ItemPipeline(items_of(std::forward<R>(range)) | std::views::transform(std::move(apply)), bound);
+}
+
+template<typename R, typename Function> requires PipelineSource<R>
+constexpr auto operator|(R &&range, MapKeys<Function> map) {
+    const size_t bound = size_bound(range);
+    auto apply = [function = std::move(map.function)]<typename T>(T &&item) {
+        using Result = stored_t<decltype(std::invoke(function, pair_key(std::forward<T>(item))))>;
+        return Item<Result, pair_value_t<T> >{
+            std::invoke(function, pair_key(std::forward<T>(item))), pair_value(std::forward<T>(item))
+        };
+    };
+    return ItemPipeline(items_of(std::forward<R>(range)) | std::views::transform(std::move(apply)), bound);
+}
+
+template<typename DictType, typename Keys> requires requires(DictType &dict) { dict.items(); dict.find(*std::ranges::begin(std::declval<Keys &>())); }
+constexpr auto operator|(DictType &dict, SelectKeys<Keys> select) {
+    const size_t bound = std::min(size_bound(select.keys), static_cast<size_t>(dict.size()));
+    auto *source = &dict;
+    auto found = std::move(select.keys)
+                 | std::views::transform([source](const auto &key) { return source->find(key); })
+                 | std::views::filter([source](const auto &it) { return it != source->items().end(); })
+                 | std::views::transform([](const auto &it) { return *it; });
+    return ItemPipeline(std::move(found), bound);
+}
+}
+
+/// Materialise a pipeline (or any range of key-value pairs) into a dictionary, allocating its
+/// storage once for the size bound of the pipeline
+///
+/// @tparam DictType Type of the dictionary (default: a `Dict` of the key and value types of the range)
+///
+/// @param range Pipeline or range of key-value pairs
+///
+/// @return The dictionary
+template<typename DictType = void, ItemRange R>
+auto to_dict(R &&range) {
+    using Reference = std::ranges::range_reference_t<R>;
+    using Result = std::conditional_t<std::is_void_v<DictType>,
+        Dict<detail::materialised_t<decltype(pair_key(std::declval<Reference>()))>,
+            detail::materialised_t<decltype(pair_value(std::declval<Reference>()))> >, DictType>;
+    Result dict;
+    dict.update(std::forward<R>(range));
+    return dict;
+}
+
+/// Materialise a pipeline into a dictionary: `dict | filter_items(p) | to_dict()`
+///
+/// @tparam DictType Type of the dictionary (default: a `Dict` of the key and value types of the pipeline)
+///
+/// @return Adaptor applied to a pipeline with `|`
+template<typename DictType = void>
+constexpr detail::ToDict<DictType> to_dict() {
+    return {};
+}
+
+namespace detail {
+template<ItemRange R, typename DictType>
+auto operator|(R &&range, ToDict<DictType>) {
+    return dictcpp::to_dict<DictType>(std::forward<R>(range));
+}
+}
+}
+
+#endif //DICTCPP_DICT_RANGES_HPP
@@ -1,9 +1,44 @@
 #ifndef DICTCPP_HPP
 #define DICTCPP_HPP
-#include <set>
+#include <string>
 #include <vector>
+#include <limits>
+#include <cstddef>
+#include <ranges>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <string_view>
 #include <optional>
 #include <stdexcept>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <bit>
+#include <thread>
+#include <cstdint>
+#include <exception>
+#include <compare>
+
+#if defined(DICTCPP_ENABLE_STATS)
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <ostream>
+#include <unordered_set>
+#endif
+
+#if !defined(DICTCPP_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DICTCPP_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#define DICTCPP_AVX2
+#include <immintrin.h>
+#endif
+#endif
 
 namespace dictcpp {
 /// A structure representing a single item (key-value pair) in a dictionary.
@@ -17,77 +52,2633 @@ struct Item {
     Value value;
 };
 
-/// A C++ implementation of a Python-like dictionary
-///
-/// @tparam Key Type of dictionary `keys`
-/// @tparam Value Type of dictionary `values` (default: `Key`)
-template<typename Key, typename Value = Key>
-class Dict {
-    std::vector<Key> key_list;
-    std::vector<Value> val_list;
+/// Key-value pairs accepted from other containers: `Item`s, or tuple-like types of two
+/// elements, such as the `std::pair`s of `std::map` and `std::unordered_map`
+///
+/// @tparam T Type of the pair (possibly a reference)
+template<typename T>
+concept KeyValuePair = requires(T &item) {
+    item.key;
+    item.value;
+} || requires(T &item) {
+    requires std::tuple_size<std::remove_cvref_t<T> >::value == 2;
+    std::get<0>(item);
+    std::get<1>(item);
+};
+
+/// Ranges of `KeyValuePair`s, e.g. `std::map`, `std::unordered_map` or a `std::vector` of `std::pair`s
+///
+/// @tparam R Type of the range (possibly a reference)
+template<typename R>
+concept ItemRange = std::ranges::input_range<R> && KeyValuePair<std::ranges::range_reference_t<R> >;
+
+/// Get the key of a `KeyValuePair`, moved from an rvalue
+///
+/// @param item Key-value pair
+///
+/// @return Reference to the key
+template<KeyValuePair T>
+constexpr decltype(auto) pair_key(T &&item) {
+    if constexpr (requires { item.key; }) {
+        return (std::forward<T>(item).key);
+    } else {
+        return std::get<0>(std::forward<T>(item));
+    }
+}
+
+/// Get the value of a `KeyValuePair`, moved from an rvalue
+///
+/// @param item Key-value pair
+///
+/// @return Reference to the value
+template<KeyValuePair T>
+constexpr decltype(auto) pair_value(T &&item) {
+    if constexpr (requires { item.value; }) {
+        return (std::forward<T>(item).value);
+    } else {
+        return std::get<1>(std::forward<T>(item));
+    }
+}
+
+/// Default hash function for dictionary keys (`std::hash<Key>`)
+///
+/// @tparam Key Type of dictionary `keys`
+template<typename Key>
+struct Hash : std::hash<Key> {
+};
+
+/// Default hash function for string keys. The hash is transparent, so that `std::string_view`
+/// and string literals can be used to look up keys without constructing a string.
+///
+/// @tparam CharT Character type
+/// @tparam Traits Character traits
+/// @tparam Alloc String allocator
+template<typename CharT, typename Traits, typename Alloc>
+struct Hash<std::basic_string<CharT, Traits, Alloc> > {
+    using is_transparent = void;
+
+    size_t operator()(const std::basic_string_view<CharT, Traits> value) const noexcept {
+        return std::hash<std::basic_string_view<CharT, Traits> >{}(value);
+    }
+};
+
+/// Search kernels used by `Dict`. They are vectorised with SSE2 or AVX2 when the compiler
+/// targets them (e.g. with `-mavx2` or `/arch:AVX2`), with portable scalar fallbacks otherwise.
+/// Define `DICTCPP_NO_SIMD` to always use the scalar versions.
+namespace simd {
+/// Types whose values are equal exactly when their bytes are, so that they can be compared
+/// by vector instructions
+template<typename T>
+concept BytewiseComparable = (std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>)
+                             && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+#if defined(DICTCPP_SSE2)
+// Bit mask with one bit per byte of the `Width` bytes at `data`, set for all bytes of the
+// elements equal to `value`
+template<size_t Width, typename T>
+uint32_t match_bytes(const T *data, const T value) {
+#if defined(DICTCPP_AVX2)
+    if constexpr (Width == 32) {
+        const auto elements = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+        __m256i equal;
+        if constexpr (sizeof(T) == 1) {
+            equal = _mm256_cmpeq_epi8(elements, _mm256_set1_epi8(std::bit_cast<int8_t>(value)));
+        } else if constexpr (sizeof(T) == 2) {
+            equal = _mm256_cmpeq_epi16(elements, _mm256_set1_epi16(std::bit_cast<int16_t>(value)));
+        } else if constexpr (sizeof(T) == 4) {
+            equal = _mm256_cmpeq_epi32(elements, _mm256_set1_epi32(std::bit_cast<int32_t>(value)));
+        } else {
+            equal = _mm256_cmpeq_epi64(elements, _mm256_set1_epi64x(std::bit_cast<int64_t>(value)));
+        }
+        return static_cast<uint32_t>(_mm256_movemask_epi8(equal));
+    }
+#endif
+    static_assert(Width == 16 || Width == 32);
+    const auto elements = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+    __m128i equal;
+    if constexpr (sizeof(T) == 1) {
+        equal = _mm_cmpeq_epi8(elements, _mm_set1_epi8(std::bit_cast<int8_t>(value)));
+    } else if constexpr (sizeof(T) == 2) {
+        equal = _mm_cmpeq_epi16(elements, _mm_set1_epi16(std::bit_cast<int16_t>(value)));
+    } else if constexpr (sizeof(T) == 4) {
+        equal = _mm_cmpeq_epi32(elements, _mm_set1_epi32(std::bit_cast<int32_t>(value)));
+    } else {
+        // SSE2 has no 64-bit comparison: both 32-bit halves must be equal
+        const auto halves = _mm_cmpeq_epi32(elements, _mm_set1_epi64x(std::bit_cast<int64_t>(value)));
+        equal = _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+    return static_cast<uint32_t>(_mm_movemask_epi8(equal));
+}
+
+// Search the elements from `i` on in vectors of `Width` bytes, as long as whole vectors lie
+// within `capacity`. Returns the position of `value`, or `n` if it was not found (with `i`
+// the first position which was not searched).
+template<size_t Width, typename T>
+size_t find_vectorised(const T *data, const size_t n, const size_t capacity, const T value, size_t &i) {
+    constexpr size_t lanes = Width / sizeof(T);
+    for (; i < n && i + lanes <= capacity; i += lanes) {
+        auto matches = match_bytes<Width>(data + i, value);
+        if (n - i < lanes) {
+            matches &= (uint32_t{1} << (n - i) * sizeof(T)) - 1;
+        }
+        if (matches != 0) {
+            return i + static_cast<size_t>(std::countr_zero(matches)) / sizeof(T);
+        }
+    }
+    return n;
+}
+#endif
+
+/// Position of the first of the `n` elements at `data` equal to `value`, `n` if there is none.
+/// Whole vectors are compared, so elements up to `capacity` (allocated, though not necessarily
+/// constructed) may be read, but only the first `n` can match.
+///
+/// @tparam T Element type
+/// @param data Elements
+/// @param n Number of elements
+/// @param capacity Number of elements allocated at `data`
+/// @param value Value to find
+///
+/// @return Position of `value`, `n` if there is none
+template<BytewiseComparable T>
+size_t find(const T *data, const size_t n, [[maybe_unused]] const size_t capacity, const T value) {
+    size_t i = 0;
+#if defined(DICTCPP_AVX2)
+    if (const auto position = find_vectorised<32>(data, n, capacity, value, i); position != n) {
+        return position;
+    }
+#endif
+#if defined(DICTCPP_SSE2)
+    if (const auto position = find_vectorised<16>(data, n, capacity, value, i); position != n) {
+        return position;
+    }
+#endif
+    for (; i < n; ++i) {
+        if (data[i] == value) {
+            return i;
+        }
+    }
+    return n;
+}
+
+/// Control byte of an empty slot of a hash table
+inline constexpr int8_t empty_control = -128;
+
+/// Control byte of a slot whose entry has been deleted
+inline constexpr int8_t deleted_control = -2;
+
+/// The control bytes of a group of slots in a hash table (as in SwissTable). The control byte
+/// of a full slot holds a 7-bit fingerprint of the hash of its key, otherwise it has its top
+/// bit set (`empty_control` or `deleted_control`). All slots of a group are tested at once,
+/// giving a bit mask of matching slots, which is read using `lowest()`.
+struct Group {
+#if defined(DICTCPP_SSE2)
+    static constexpr size_t width = 16;
+
+    __m128i bytes;
+
+    explicit Group(const int8_t *control) : bytes(_mm_loadu_si128(reinterpret_cast<const __m128i *>(control))) {
+    }
+
+    [[nodiscard]] uint64_t match(const int8_t fingerprint) const {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(fingerprint))));
+    }
+
+    [[nodiscard]] uint64_t match_empty() const {
+        return match(empty_control);
+    }
+
+    [[nodiscard]] uint64_t match_free() const {
+        return static_cast<uint32_t>(_mm_movemask_epi8(bytes));
+    }
+
+    static size_t lowest(const uint64_t matches) {
+        return static_cast<size_t>(std::countr_zero(matches));
+    }
+#else
+    // Portable version, testing the 8 bytes of a 64-bit word at once (SWAR). Each slot
+    // corresponds to the top bit of its byte in a mask.
+    static constexpr size_t width = 8;
+    static constexpr uint64_t low_bits = 0x0101010101010101;
+    static constexpr uint64_t high_bits = 0x8080808080808080;
+
+    uint64_t bytes = 0;
+
+    explicit Group(const int8_t *control) {
+        for (size_t i = 0; i < width; ++i) {
+            bytes |= static_cast<uint64_t>(static_cast<uint8_t>(control[i])) << 8 * i;
+        }
+    }
+
+    // May give false positives for full slots following a match, which the caller rejects
+    // when it compares the keys
+    [[nodiscard]] uint64_t match(const int8_t fingerprint) const {
+        const auto difference = bytes ^ (low_bits * static_cast<uint8_t>(fingerprint));
+        return (difference - low_bits) & ~difference & high_bits;
+    }
+
+    [[nodiscard]] uint64_t match_empty() const {
+        return bytes & ~(bytes << 6) & high_bits;
+    }
+
+    [[nodiscard]] uint64_t match_free() const {
+        return bytes & high_bits;
+    }
+
+    static size_t lowest(const uint64_t matches) {
+        return static_cast<size_t>(std::countr_zero(matches)) / 8;
+    }
+#endif
+};
+}
+
+/// A vector which stores up to `N` elements inline (in the object itself), only allocating
+/// storage on the heap once it grows beyond `N` elements. Used by `Dict` for the entries of
+/// small dictionaries. Only the subset of the `std::vector` interface needed by `Dict` is
+/// provided.
+///
+/// @tparam T Element type
+/// @tparam N Number of elements stored inline
+/// @tparam Allocator Allocator for heap storage and element construction (default: `std::allocator<T>`)
+template<typename T, size_t N, typename Allocator = std::allocator<T> >
+class SmallVector {
+    static_assert(N > 0, "SmallVector requires an inline capacity, use std::vector otherwise");
+
+    using Traits = std::allocator_traits<Allocator>;
+
+    [[no_unique_address]] Allocator allocator;
+    T *elements;
+    size_t count = 0;
+    size_t reserved = N;
+    alignas(T) std::byte buffer[N * sizeof(T)];
+
+    T *inline_elements() noexcept {
+        return reinterpret_cast<T *>(buffer);
+    }
+
+    [[nodiscard]] bool is_inline() const noexcept {
+        return reserved == N;
+    }
+
+    // Construct elements at `destination` by moving `n` elements from `source`, destroying
+    // those already constructed if this throws
+    void move_construct(T *source, T *destination, const size_t n) {
+        size_t i = 0;
+        try {
+            for (; i < n; ++i) {
+                Traits::construct(allocator, destination + i, std::move(source[i]));
+            }
+        } catch (...) {
+            destroy(destination, destination + i);
+            throw;
+        }
+    }
+
+    void copy_construct(const T *source, T *destination, const size_t n) {
+        size_t i = 0;
+        try {
+            for (; i < n; ++i) {
+                Traits::construct(allocator, destination + i, source[i]);
+            }
+        } catch (...) {
+            destroy(destination, destination + i);
+            throw;
+        }
+    }
+
+    void destroy(T *first, T *last) noexcept {
+        for (; first != last; ++first) {
+            Traits::destroy(allocator, first);
+        }
+    }
+
+    // Move the elements to storage for `n` elements (inline if `n == N`). New storage is
+    // allocated before anything is moved, so that the vector is unchanged if this throws.
+    void reallocate(const size_t n) {
+        T *new_elements = n == N ? inline_elements() : Traits::allocate(allocator, n);
+        if (new_elements != elements) {
+            try {
+                move_construct(elements, new_elements, count);
+            } catch (...) {
+                if (n != N) {
+                    Traits::deallocate(allocator, new_elements, n);
+                }
+                throw;
+            }
+            destroy(elements, elements + count);
+            release();
+        }
+        elements = new_elements;
+        reserved = n;
+    }
+
+    // Free heap storage, if any (the elements must already be destroyed)
+    void release() noexcept {
+        if (!is_inline()) {
+            Traits::deallocate(allocator, elements, reserved);
+        }
+    }
+
+    // Take the elements of `other`, leaving it empty. Heap storage is transferred as a whole,
+    // which requires both allocators to be equal.
+    void take(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (other.is_inline()) {
+            elements = inline_elements();
+            reserved = N;
+            move_construct(other.elements, elements, other.count);
+            count = other.count;
+            other.clear();
+        } else {
+            elements = other.elements;
+            count = other.count;
+            reserved = other.reserved;
+            other.elements = other.inline_elements();
+            other.count = 0;
+            other.reserved = N;
+        }
+    }
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    SmallVector() noexcept(noexcept(Allocator())) : SmallVector(Allocator()) {
+    }
+
+    explicit SmallVector(const Allocator &allocator) noexcept : allocator(allocator), elements(inline_elements()) {
+    }
+
+    SmallVector(const SmallVector &other)
+        : SmallVector(other, Traits::select_on_container_copy_construction(other.allocator)) {
+    }
+
+    SmallVector(const SmallVector &other, const Allocator &allocator) : SmallVector(allocator) {
+        reserve(other.count);
+        copy_construct(other.elements, elements, other.count);
+        count = other.count;
+    }
+
+    SmallVector(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : allocator(std::move(other.allocator)) {
+        take(std::move(other));
+    }
+
+    SmallVector &operator=(const SmallVector &other) {
+        if (this != &other) {
+            clear();
+            if constexpr (Traits::propagate_on_container_copy_assignment::value) {
+                if (allocator != other.allocator) {
+                    shrink_to_fit();
+                }
+                allocator = other.allocator;
+            }
+            reserve(other.count);
+            copy_construct(other.elements, elements, other.count);
+            count = other.count;
+        }
+        return *this;
+    }
+
+    SmallVector &operator=(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>
+                                                         && (Traits::propagate_on_container_move_assignment::value
+                                                             || Traits::is_always_equal::value)) {
+        if (this == &other) {
+            return *this;
+        }
+
+        clear();
+        if constexpr (Traits::propagate_on_container_move_assignment::value) {
+            release();
+            allocator = std::move(other.allocator);
+            take(std::move(other));
+        } else if (allocator == other.allocator) {
+            release();
+            take(std::move(other));
+        } else {
+            // Storage from another allocator cannot be taken over, so the elements are moved
+            reserve(other.count);
+            move_construct(other.elements, elements, other.count);
+            count = other.count;
+            other.clear();
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        clear();
+        release();
+    }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept {
+        return allocator;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return count == 0;
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return count;
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept {
+        return reserved;
+    }
+
+    T *data() noexcept {
+        return elements;
+    }
+
+    const T *data() const noexcept {
+        return elements;
+    }
+
+    iterator begin() noexcept {
+        return elements;
+    }
+
+    const_iterator begin() const noexcept {
+        return elements;
+    }
+
+    iterator end() noexcept {
+        return elements + count;
+    }
+
+    const_iterator end() const noexcept {
+        return elements + count;
+    }
+
+    T &operator[](const size_t i) noexcept {
+        return elements[i];
+    }
+
+    const T &operator[](const size_t i) const noexcept {
+        return elements[i];
+    }
+
+    T &back() noexcept {
+        return elements[count - 1];
+    }
+
+    const T &back() const noexcept {
+        return elements[count - 1];
+    }
+
+    void reserve(const size_t n) {
+        if (n > reserved) {
+            reallocate(n);
+        }
+    }
+
+    /// Release unused heap storage, moving the elements back inline if they fit
+    void shrink_to_fit() {
+        if (!is_inline() && count < reserved) {
+            reallocate(std::max(count, N));
+        }
+    }
+
+    template<typename... Args>
+    T &emplace_back(Args &&... args) {
+        if (count == reserved) {
+            // The new element is constructed before the others are moved, as `args` may refer to them
+            const auto n = 2 * reserved;
+            T *new_elements = Traits::allocate(allocator, n);
+            try {
+                Traits::construct(allocator, new_elements + count, std::forward<Args>(args)...);
+                try {
+                    move_construct(elements, new_elements, count);
+                } catch (...) {
+                    Traits::destroy(allocator, new_elements + count);
+                    throw;
+                }
+            } catch (...) {
+                Traits::deallocate(allocator, new_elements, n);
+                throw;
+            }
+            destroy(elements, elements + count);
+            release();
+            elements = new_elements;
+            reserved = n;
+        } else {
+            Traits::construct(allocator, elements + count, std::forward<Args>(args)...);
+        }
+        return elements[count++];
+    }
+
+    void push_back(const T &value) {
+        emplace_back(value);
+    }
+
+    void push_back(T &&value) {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back() noexcept {
+        Traits::destroy(allocator, elements + --count);
+    }
+
+    iterator erase(const iterator first, const iterator last) {
+        if (first != last) {
+            const auto new_end = std::move(last, end(), first);
+            destroy(new_end, end());
+            count = static_cast<size_t>(new_end - elements);
+        }
+        return first;
+    }
+
+    iterator erase(const iterator position) {
+        return erase(position, position + 1);
+    }
+
+    void clear() noexcept {
+        destroy(elements, elements + count);
+        count = 0;
+    }
+
+    /// Bytes of heap storage (none while the elements are inline)
+    [[nodiscard]] size_t heap_bytes() const noexcept {
+        return is_inline() ? 0 : reserved * sizeof(T);
+    }
+};
+
+/// Reference to a single bit of a `BitList`, which converts to `bool` and assigns the bit
+/// from a `bool`
+class BitReference {
+    uint64_t *word;
+    uint64_t mask;
+
+public:
+    BitReference(uint64_t *word, const size_t bit) noexcept : word(word), mask(uint64_t{1} << bit) {
+    }
+
+    BitReference(const BitReference &other) = default;
+
+    operator bool() const noexcept {
+        return (*word & mask) != 0;
+    }
+
+    // Assigning from another reference copies the bit, rather than rebinding the reference
+    BitReference &operator=(const BitReference &other) noexcept {
+        *this = static_cast<bool>(other);
+        return *this;
+    }
+
+    const BitReference &operator=(const bool value) const noexcept {
+        *word = value ? *word | mask : *word & ~mask;
+        return *this;
+    }
+
+    void flip() const noexcept {
+        *word ^= mask;
+    }
+};
+
+/// A list of `bool`s packed into 64-bit words, used by `Dict<Key, bool>` for its values.
+/// The bits past the end of the list are always zero, so that whole words can be counted.
+///
+/// @tparam Words List of `uint64_t` words (`std::vector` or `SmallVector`)
+template<typename Words>
+class BitList {
+    Words words;
+    size_t bits = 0;
+
+    static size_t words_for(const size_t n) {
+        return (n + 63) / 64;
+    }
+
+    // Drop the bits from position `n` on
+    void truncate(const size_t n) {
+        words.erase(words.begin() + static_cast<std::ptrdiff_t>(words_for(n)), words.end());
+        if (n % 64 != 0) {
+            words.back() &= (uint64_t{1} << n % 64) - 1;
+        }
+        bits = n;
+    }
+
+public:
+    using allocator_type = typename Words::allocator_type;
+
+    /// Position in the list, as taken by `erase()`
+    struct iterator {
+        size_t index;
+
+        iterator operator+(const std::ptrdiff_t n) const {
+            return {index + static_cast<size_t>(n)};
+        }
+    };
+
+    BitList() = default;
+
+    explicit BitList(const allocator_type &allocator) : words(allocator) {
+    }
+
+    BitList(const BitList &other) = default;
+
+    BitList(const BitList &other, const allocator_type &allocator) : words(other.words, allocator), bits(other.bits) {
+    }
+
+    BitList(BitList &&other) noexcept(std::is_nothrow_move_constructible_v<Words>)
+        : words(std::move(other.words)), bits(std::exchange(other.bits, 0)) {
+    }
+
+    BitList &operator=(const BitList &other) = default;
+
+    BitList &operator=(BitList &&other) noexcept(std::is_nothrow_move_assignable_v<Words>) {
+        words = std::move(other.words);
+        bits = std::exchange(other.bits, 0);
+        return *this;
+    }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept {
+        return words.get_allocator();
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return bits == 0;
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return bits;
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept {
+        return words.capacity() * 64;
+    }
+
+    iterator begin() const noexcept {
+        return {0};
+    }
+
+    iterator end() const noexcept {
+        return {bits};
+    }
+
+    BitReference operator[](const size_t i) noexcept {
+        return {&words[i / 64], i % 64};
+    }
+
+    bool operator[](const size_t i) const noexcept {
+        return (words[i / 64] >> i % 64 & 1) != 0;
+    }
+
+    void reserve(const size_t n) {
+        words.reserve(words_for(n));
+    }
+
+    void shrink_to_fit() {
+        words.shrink_to_fit();
+    }
+
+    template<typename... Args>
+    BitReference emplace_back(Args &&... args) {
+        const bool value(std::forward<Args>(args)...);
+        if (bits % 64 == 0) {
+            words.push_back(0);
+        }
+        const auto reference = (*this)[bits++];
+        reference = value;
+        return reference;
+    }
+
+    void push_back(const bool value) {
+        emplace_back(value);
+    }
+
+    void pop_back() noexcept {
+        truncate(bits - 1);
+    }
+
+    iterator erase(const iterator first, const iterator last) {
+        const auto n = last.index - first.index;
+        for (size_t i = last.index; i < bits; ++i) {
+            (*this)[i - n] = (*this)[i];
+        }
+        truncate(bits - n);
+        return first;
+    }
+
+    iterator erase(const iterator position) {
+        return erase(position, position + 1);
+    }
+
+    void clear() noexcept {
+        words.clear();
+        bits = 0;
+    }
+
+    /// Number of bits which are set
+    [[nodiscard]] size_t popcount() const noexcept {
+        size_t n = 0;
+        for (size_t i = 0; i < words.size(); ++i) {
+            n += static_cast<size_t>(std::popcount(words[i]));
+        }
+        return n;
+    }
+
+    /// Whether any bit is set
+    [[nodiscard]] bool any() const noexcept {
+        for (size_t i = 0; i < words.size(); ++i) {
+            if (words[i] != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Flip all bits
+    void flip() noexcept {
+        for (size_t i = 0; i < words.size(); ++i) {
+            words[i] = ~words[i];
+        }
+        if (bits % 64 != 0) {
+            words.back() &= (uint64_t{1} << bits % 64) - 1;
+        }
+    }
+
+    /// Bytes of heap storage
+    [[nodiscard]] size_t heap_bytes() const noexcept {
+        if constexpr (requires { words.heap_bytes(); }) {
+            return words.heap_bytes();
+        } else {
+            return words.capacity() * sizeof(uint64_t);
+        }
+    }
+};
+
+/// Default number of items stored inline by a `Dict`: as many as fit in 256 bytes, at most 16
+///
+/// @tparam Key Type of dictionary `keys`
+/// @tparam Value Type of dictionary `values`
+template<typename Key, typename Value>
+inline constexpr size_t default_inline_capacity = std::min<size_t>(16, 256 / (sizeof(Key) + sizeof(Value) + sizeof(size_t)));
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, size_t InlineCapacity, typename Allocator>
+class Dict;
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+class LruDict;
+
+/// Counts of the work done by a dictionary, recorded if `DICTCPP_ENABLE_STATS` is defined
+/// (see `Dict::stats()`)
+struct DictStats {
+    /// Key lookups, including those of insertions and deletions
+    size_t lookups = 0;
+    /// Lookups which found the key
+    size_t hits = 0;
+    /// Lookups which did not find the key
+    size_t misses = 0;
+    /// Groups of slots probed in the index (small dictionaries are scanned without an index)
+    size_t probes = 0;
+    /// Most groups probed by a single lookup
+    size_t max_probe_length = 0;
+    /// Keys compared after a matching fingerprint or hash (small dictionaries of integers,
+    /// enums or pointers compare all keys at once, which is not counted)
+    size_t key_comparisons = 0;
+    /// Items inserted
+    size_t insertions = 0;
+    /// Items deleted
+    size_t deletions = 0;
+    /// Rebuilds of the index and entries (to grow the index, or to drop the tombstones)
+    size_t rebuilds = 0;
+    /// Rebuilds which grew the index
+    size_t growths = 0;
+    /// Heap allocations of the entry lists and index
+    size_t allocations = 0;
+    /// Bytes of the heap allocations
+    size_t allocated_bytes = 0;
+
+    /// Add the counts of `other` (taking the maximum of `max_probe_length`)
+    ///
+    /// @param other Statistics to add
+    ///
+    /// @return These statistics
+    DictStats &operator+=(const DictStats &other) {
+        lookups += other.lookups;
+        hits += other.hits;
+        misses += other.misses;
+        probes += other.probes;
+        max_probe_length = std::max(max_probe_length, other.max_probe_length);
+        key_comparisons += other.key_comparisons;
+        insertions += other.insertions;
+        deletions += other.deletions;
+        rebuilds += other.rebuilds;
+        growths += other.growths;
+        allocations += other.allocations;
+        allocated_bytes += other.allocated_bytes;
+        return *this;
+    }
+
+    bool operator==(const DictStats &other) const = default;
+};
+
+/// Memory held by a dictionary, as returned by `Dict::memory_usage()`. Memory owned by the
+/// keys and values themselves (such as the characters of long strings) is not included.
+struct MemoryUsage {
+    /// Bytes of the dictionary object (including any entries stored inline) and of its heap storage
+    size_t allocated = 0;
+    /// Bytes of the live entries (keys, values and hashes) and of their slots in the index
+    size_t used = 0;
+};
+
+/// Number of threads used by the parallel bulk operations of `Dict`, such as
+/// `Dict(items, Parallel{8})` or `update(other, Parallel{})`
+struct Parallel {
+    /// Number of threads (default: the number of hardware threads)
+    size_t threads = std::max(std::thread::hardware_concurrency(), 1U);
+};
+
+namespace detail {
+// Call `function(part, first, last)` for each of `parts` parts of the range [0, `count`), each on
+// its own thread (the first on the calling thread), then rethrow the first exception thrown
+template<typename Function>
+void parallel_for(const size_t count, const size_t parts, const Function &function) {
+    std::vector<std::exception_ptr> errors(parts);
+    const auto run = [&](const size_t part) {
+        try {
+            function(part, count * part / parts, count * (part + 1) / parts);
+        } catch (...) {
+            errors[part] = std::current_exception();
+        }
+    };
+    {
+        std::vector<std::jthread> workers;
+        for (size_t part = 1; part < parts; ++part) {
+            workers.emplace_back(run, part);
+        }
+        run(0);
+    }
+    for (const auto &error: errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+// Sets of keys which can be probed without a search: key views and dictionaries
+template<typename S>
+concept ProbedKeys = std::ranges::forward_range<const S> && std::ranges::sized_range<const S> &&
+                     requires(const S &keys, std::ranges::range_reference_t<const S> key) {
+                         { keys.contains(key) } -> std::convertible_to<bool>;
+                     };
+
+// Collect the keys of any range into a set of keys (a dictionary). Other types of keys are
+// looked up as they are if the set allows it (so that only the inserted ones are converted),
+// and otherwise converted explicitly.
+template<typename KeySet, typename R>
+KeySet collect_keys(R &&keys) {
+    using Key = std::remove_cvref_t<std::ranges::range_reference_t<KeySet> >;
+    KeySet set;
+    if constexpr (std::ranges::sized_range<R>) {
+        set.reserve(static_cast<size_t>(std::ranges::size(keys)));
+    }
+    for (auto &&key: keys) {
+        using K = std::remove_cvref_t<decltype(key)>;
+        if constexpr (std::is_same_v<K, Key>) {
+            set.try_emplace(std::forward<decltype(key)>(key), true);
+        } else if constexpr (requires(KeySet &keys_set, const K &other) { keys_set[other] = true; }) {
+            set[std::as_const(key)] = true;
+        } else {
+            set.try_emplace(Key(std::forward<decltype(key)>(key)), true);
+        }
+    }
+    return set;
+}
+}
+
+#if defined(DICTCPP_ENABLE_STATS)
+/// Write the statistics of a dictionary as `name=count` pairs
+///
+/// @param out Output stream
+/// @param stats Dictionary statistics
+///
+/// @return `out`
+inline std::ostream &operator<<(std::ostream &out, const DictStats &stats) {
+    return out << "lookups=" << stats.lookups << " hits=" << stats.hits << " misses=" << stats.misses
+           << " probes=" << stats.probes << " max_probe_length=" << stats.max_probe_length
+           << " key_comparisons=" << stats.key_comparisons << " insertions=" << stats.insertions
+           << " deletions=" << stats.deletions << " rebuilds=" << stats.rebuilds << " growths=" << stats.growths
+           << " allocations=" << stats.allocations << " allocated_bytes=" << stats.allocated_bytes;
+}
+
+/// The live dictionaries of type `DictType`, and the statistics of those already destroyed
+///
+/// @tparam DictType Dictionary type
+template<typename DictType>
+class StatsRegistry {
+    std::mutex mutex;
+    std::unordered_set<const DictType *> dicts;
+    DictStats retired;
+
+public:
+    /// The registry of `DictType`, which is never destroyed, so that dictionaries with static
+    /// storage duration can still be removed from it
+    static StatsRegistry &instance() {
+        static auto *const registry = new StatsRegistry;
+        return *registry;
+    }
+
+    void add(const DictType *dict) {
+        const std::lock_guard lock(mutex);
+        dicts.insert(dict);
+    }
+
+    void remove(const DictType *dict, const DictStats &stats) {
+        const std::lock_guard lock(mutex);
+        dicts.erase(dict);
+        retired += stats;
+    }
+
+    template<typename Function>
+    void for_each(Function &&function) {
+        const std::lock_guard lock(mutex);
+        for (const auto *dict: dicts) {
+            function(*dict);
+        }
+    }
+
+    DictStats total() {
+        const std::lock_guard lock(mutex);
+        auto stats = retired;
+        for (const auto *dict: dicts) {
+            stats += dict->stats();
+        }
+        return stats;
+    }
+};
+
+/// The statistics of a dictionary, which keep it registered in the `StatsRegistry` of its type
+/// while it exists. Statistics belong to the dictionary object, so are not copied when the
+/// dictionary is.
+///
+/// The counts are atomic (updated with relaxed ordering), as `const` lookups update them, and
+/// any number of threads may look up keys in a dictionary at once.
+///
+/// @tparam DictType Dictionary type
+template<typename DictType>
+class StatsRecord {
+    // The counts which are added up (all but `max_probe_length`)
+    static constexpr std::array<size_t DictStats::*, 11> counts = {
+        &DictStats::lookups, &DictStats::hits, &DictStats::misses, &DictStats::probes, &DictStats::key_comparisons,
+        &DictStats::insertions, &DictStats::deletions, &DictStats::rebuilds, &DictStats::growths,
+        &DictStats::allocations, &DictStats::allocated_bytes
+    };
+
+    const DictType *dict;
+    std::array<std::atomic<size_t>, counts.size()> totals{};
+    std::atomic<size_t> max_probe_length = 0;
+
+public:
+    explicit StatsRecord(const DictType *dict) : dict(dict) {
+        StatsRegistry<DictType>::instance().add(dict);
+    }
+
+    StatsRecord(const StatsRecord &) = delete;
+
+    StatsRecord &operator=(const StatsRecord &) noexcept {
+        return *this;
+    }
+
+    ~StatsRecord() {
+        StatsRegistry<DictType>::instance().remove(dict, load());
+    }
+
+    /// Add the counts of `stats` (taking the maximum of `max_probe_length`)
+    ///
+    /// @param stats Statistics to add
+    void add(const DictStats &stats) {
+        for (size_t i = 0; i < counts.size(); ++i) {
+            if (const auto count = stats.*counts[i]; count != 0) {
+                totals[i].fetch_add(count, std::memory_order_relaxed);
+            }
+        }
+        auto longest = max_probe_length.load(std::memory_order_relaxed);
+        while (stats.max_probe_length > longest
+               && !max_probe_length.compare_exchange_weak(longest, stats.max_probe_length, std::memory_order_relaxed)) {
+        }
+    }
+
+    /// Get the statistics recorded so far
+    ///
+    /// @return Copy of the statistics
+    [[nodiscard]] DictStats load() const {
+        DictStats stats;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            stats.*counts[i] = totals[i].load(std::memory_order_relaxed);
+        }
+        stats.max_probe_length = max_probe_length.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    /// Reset the statistics to zero
+    void reset() {
+        for (auto &total: totals) {
+            total.store(0, std::memory_order_relaxed);
+        }
+        max_probe_length.store(0, std::memory_order_relaxed);
+    }
+};
+#endif
+
+/// Random-access iterator through the live entries of a dictionary in insertion order.
+/// Dereferencing gives the key, value or item (key-value pair) of the entry, depending
+/// on `Access`.
+///
+/// Items are built on access, and returned by value as `Item`s of references to the key and
+/// value (proxy references, as those of `std::views::zip`), so they are bound without copies as
+/// in `for (auto [key, value]: dict.items())` or `for (auto &&[key, value]: dict.items())`.
+///
+/// Moving by more than one entry is constant time, unless entries have been deleted since the
+/// dictionary was last compacted: the deleted entries are then skipped one by one.
+///
+/// @tparam DictType Dictionary type (`const` for constant access)
+/// @tparam Access Accessor for the entry at a given position
+template<typename DictType, typename Access>
+class DictIterator {
+    DictType *dict = nullptr;
+    size_t index = 0;
+
+    template<typename D, typename A>
+    friend class DictView;
+
+public:
+    using reference = decltype(Access::get(std::declval<DictType *>(), 0));
+    using value_type = std::remove_cvref_t<reference>;
+    using difference_type = std::ptrdiff_t;
+    using iterator_concept = std::random_access_iterator_tag;
+    // Proxy references only meet the requirements of input iterators of the standard library
+    using iterator_category = std::conditional_t<std::is_lvalue_reference_v<reference>,
+        std::random_access_iterator_tag, std::input_iterator_tag>;
+
+    // Items (and values of `Dict<Key, bool>`) are returned by value, so `->` goes through a
+    // proxy holding one
+    struct ArrowProxy {
+        value_type item;
+
+        constexpr const value_type *operator->() const {
+            return &item;
+        }
+    };
+
+    using pointer = std::conditional_t<std::is_lvalue_reference_v<reference>, std::add_pointer_t<reference>, ArrowProxy>;
+
+    DictIterator() = default;
+
+    constexpr DictIterator(DictType *dict, const size_t index): dict(dict), index(index) {
+    }
+
+    constexpr reference operator*() const {
+        return Access::get(dict, index);
+    }
+
+    constexpr pointer operator->() const {
+        if constexpr (std::is_lvalue_reference_v<reference>) {
+            return &Access::get(dict, index);
+        } else {
+            return ArrowProxy{Access::get(dict, index)};
+        }
+    }
+
+    constexpr reference operator[](const difference_type n) const {
+        return *(*this + n);
+    }
+
+    constexpr DictIterator &operator++() {
+        index = dict->next_live(index);
+        return *this;
+    }
+
+    constexpr DictIterator operator++(int) {
+        auto tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    constexpr DictIterator &operator--() {
+        index = dict->previous_live(index);
+        return *this;
+    }
+
+    constexpr DictIterator operator--(int) {
+        auto tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    constexpr DictIterator &operator+=(const difference_type n) {
+        if (dict->is_compact()) {
+            index += static_cast<size_t>(n);
+        } else {
+            for (auto i = n; i > 0; --i) {
+                ++*this;
+            }
+            for (auto i = n; i < 0; ++i) {
+                --*this;
+            }
+        }
+        return *this;
+    }
+
+    constexpr DictIterator &operator-=(const difference_type n) {
+        return *this += -n;
+    }
+
+    constexpr friend DictIterator operator+(DictIterator it, const difference_type n) {
+        return it += n;
+    }
+
+    constexpr friend DictIterator operator+(const difference_type n, DictIterator it) {
+        return it += n;
+    }
+
+    constexpr friend DictIterator operator-(DictIterator it, const difference_type n) {
+        return it -= n;
+    }
+
+    constexpr difference_type operator-(const DictIterator &other) const {
+        if (dict == nullptr || dict->is_compact()) {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+        }
+        const auto [first, last] = std::minmax(index, other.index);
+        difference_type count = 0;
+        for (auto i = first; i < last; i = dict->next_live(i)) {
+            count++;
+        }
+        return index < other.index ? -count : count;
+    }
+
+    constexpr bool operator==(const DictIterator &other) const {
+        return index == other.index;
+    }
+
+    constexpr std::strong_ordering operator<=>(const DictIterator &other) const {
+        return index <=> other.index;
+    }
+};
+
+/// A live view of the keys, values or items of a dictionary, in insertion order (as returned
+/// by Python's `dict.keys()`, `dict.values()` and `dict.items()`). A view does not copy any
+/// entries and reflects all later changes to the dictionary.
+///
+/// @tparam DictType Dictionary type (`const` for constant access)
+/// @tparam Access Accessor for the entry at a given position
+template<typename DictType, typename Access>
+class DictView : public std::ranges::view_interface<DictView<DictType, Access> > {
+    DictType *dict = nullptr;
+
+    // Items are returned by value (rather than as references to the item kept in an iterator)
+    using element = decltype(Access::get(std::declval<DictType *>(), 0));
+
+public:
+    using iterator = DictIterator<DictType, Access>;
+
+    DictView() = default;
+
+    constexpr explicit DictView(DictType *dict): dict(dict) {
+    }
+
+    constexpr iterator begin() const {
+        return {dict, dict->head};
+    }
+
+    constexpr iterator end() const {
+        return {dict, dict->key_list.size()};
+    }
+
+    [[nodiscard]] constexpr size_t size() const {
+        return dict->used;
+    }
+
+    /// Access the element at position `n` (in insertion order). This is constant time
+    /// unless entries have been deleted since the dictionary was last compacted.
+    ///
+    /// @param n Position in the view
+    ///
+    /// @return The key, value or item at position `n`
+    constexpr element operator[](const size_t n) const {
+        return Access::get(dict, (begin() + static_cast<std::ptrdiff_t>(n)).index);
+    }
+
+    /// @return The first key, value or item
+    constexpr element front() const {
+        return Access::get(dict, dict->head);
+    }
+
+    /// @return The last key, value or item
+    constexpr element back() const {
+        return Access::get(dict, dict->key_list.size() - 1);
+    }
+
+    /// Check if the view of keys contains `key`
+    ///
+    /// @param key A possible key
+    ///
+    /// @return Whether key is present in dictionary
+    template<typename K> requires Access::set_like
+    bool contains(const K &key) const {
+        return dict->contains(key);
+    }
+
+    /// Check if the keys have none in common with `other`, as Python's `dict.keys().isdisjoint()`.
+    /// If `other` is a key view or a dictionary, the smaller side is iterated and its keys are
+    /// looked up in the other one; any other range of keys is iterated.
+    ///
+    /// @param other Key view, dictionary or range of keys
+    ///
+    /// @return Whether no key of `other` is in the view
+    template<std::ranges::input_range R> requires Access::set_like
+    bool isdisjoint(R &&other) const {
+        if constexpr (detail::ProbedKeys<std::remove_cvref_t<R> >) {
+            if (static_cast<size_t>(std::ranges::size(other)) > size()) {
+                return std::ranges::none_of(*this, [&other](const auto &key) { return other.contains(key); });
+            }
+        }
+        return std::ranges::none_of(other, [this](const auto &key) { return contains(key); });
+    }
+
+    /// Check if all the keys of the view are in `other`. A range of keys other than a key view or a
+    /// dictionary is first collected into a set.
+    ///
+    /// @param other Key view, dictionary or range of keys
+    ///
+    /// @return Whether the keys are a subset of `other`
+    template<std::ranges::input_range R> requires Access::set_like
+    bool issubset(R &&other) const {
+        if constexpr (detail::ProbedKeys<std::remove_cvref_t<R> >) {
+            return size() <= static_cast<size_t>(std::ranges::size(other)) &&
+                   std::ranges::all_of(*this, [&other](const auto &key) { return other.contains(key); });
+        } else {
+            using KeySet = typename std::remove_const_t<DictType>::KeySet;
+            return issubset(detail::collect_keys<KeySet>(std::forward<R>(other)));
+        }
+    }
+
+    /// Check if all the keys of `other` are in the view (bulk membership), stopping at the first
+    /// missing key
+    ///
+    /// @param other Key view, dictionary or range of keys
+    ///
+    /// @return Whether the keys are a superset of `other`
+    template<std::ranges::input_range R> requires Access::set_like
+    bool issuperset(R &&other) const {
+        if constexpr (detail::ProbedKeys<std::remove_cvref_t<R> >) {
+            if (static_cast<size_t>(std::ranges::size(other)) > size()) {
+                return false;
+            }
+        }
+        return std::ranges::all_of(other, [this](const auto &key) { return contains(key); });
+    }
+
+    /// Compare two views of keys as sets: they are equal if they have the same keys, in any order
+    template<typename OtherDict, typename OtherAccess> requires Access::set_like && OtherAccess::set_like
+    bool operator==(const DictView<OtherDict, OtherAccess> &other) const {
+        return size() == other.size() && issubset(other);
+    }
+
+    /// Order two views of keys as sets, by inclusion: `a < b` if the keys of `a` are a proper
+    /// subset of those of `b`. Views with keys missing from each other are unordered.
+    template<typename OtherDict, typename OtherAccess> requires Access::set_like && OtherAccess::set_like
+    std::partial_ordering operator<=>(const DictView<OtherDict, OtherAccess> &other) const {
+        if (size() > other.size()) {
+            return issuperset(other) ? std::partial_ordering::greater : std::partial_ordering::unordered;
+        }
+        if (!issubset(other)) {
+            return std::partial_ordering::unordered;
+        }
+        return size() < other.size() ? std::partial_ordering::less : std::partial_ordering::equivalent;
+    }
+};
+
+/// A C++ implementation of a Python-like dictionary
+///
+/// If both `Hash` and `KeyEqual` are transparent (define `is_transparent`), keys can be looked up
+/// with any type they accept, e.g. `std::string_view` for `std::string` keys, without constructing
+/// a `Key`. A `Key` is then only constructed when a new item is inserted.
+///
+/// Up to `InlineCapacity` items are stored inline in the `Dict` object, without any heap
+/// allocation. Such small dictionaries have no hash index: keys are found by a branch-free
+/// scan of all entries. Once the dictionary grows beyond `InlineCapacity` items, the entries
+/// are moved to the heap and indexed by hash.
+///
+/// All storage (keys, values and the hash index) is obtained from `Allocator`, rebound to each
+/// element type, and keys and values are constructed with it (so, for example, `std::pmr`
+/// strings in a `dictcpp::pmr::Dict` use the memory resource of the dictionary).
+///
+/// @tparam Key Type of dictionary `keys`
+/// @tparam Value Type of dictionary `values` (default: `Key`)
+/// @tparam Hash Hash function for keys (default: `dictcpp::Hash<Key>`)
+/// @tparam KeyEqual Equality comparison for keys (default: `std::equal_to<>`)
+/// @tparam InlineCapacity Number of items stored inline, at most 64 (default: `default_inline_capacity`)
+/// @tparam Allocator Allocator for the dictionary storage (default: `std::allocator<Item<Key, Value>>`)
+template<typename Key, typename Value = Key, typename Hash = dictcpp::Hash<Key>, typename KeyEqual = std::equal_to<>,
+    size_t InlineCapacity = default_inline_capacity<Key, Value>, typename Allocator = std::allocator<Item<Key, Value> > >
+class Dict {
+    static_assert(InlineCapacity <= 64, "Small dictionaries are scanned using a 64-bit mask");
+
+    template<typename T>
+    using AllocatorFor = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+    template<typename T>
+    using List = std::conditional_t<InlineCapacity == 0, std::vector<T, AllocatorFor<T> >,
+        SmallVector<T, InlineCapacity, AllocatorFor<T> > >;
+
+    // Values of `Dict<Key, bool>` are packed into bits, 64 to a word; at most `InlineCapacity`
+    // (so one word) are stored inline
+    static constexpr bool packed_values = std::is_same_v<Value, bool>;
+
+    using ValueList = std::conditional_t<packed_values,
+        BitList<std::conditional_t<InlineCapacity == 0, std::vector<uint64_t, AllocatorFor<uint64_t> >,
+            SmallVector<uint64_t, 1, AllocatorFor<uint64_t> > > >, List<Value> >;
+
+    List<Key> key_list;
+    ValueList val_list;
+
+    // Compact layout (as used by CPython): `key_list`, `val_list` and `hash_list` are dense and
+    // kept in insertion order, while `index_table` is a sparse open-addressing table whose slots
+    // hold positions into the dense lists. The table size is always a power of two. Each slot
+    // has a control byte in `control` (see `simd::Group`), so that the slots are probed in
+    // groups, comparing the fingerprints of a whole group at once.
+    //
+    // Deleted entries are left in place as tombstones (marked by `dead_hash`, their slot in the
+    // table by `deleted_control`) and removed in a single pass by `compact()`. Entries before
+    // `head` are all deleted and the last entry is always live, so an empty dictionary has no
+    // entries.
+    //
+    // Small dictionaries (at most `InlineCapacity` entries) have no `index_table` and no
+    // tombstones: deleted entries are removed immediately.
+    List<size_t> hash_list;
+    std::vector<size_t, AllocatorFor<size_t> > index_table;
+    std::vector<int8_t, AllocatorFor<int8_t> > control;
+    size_t used = 0;
+    size_t filled = 0;
+    size_t head = 0;
+    [[no_unique_address]] Hash hasher;
+    [[no_unique_address]] KeyEqual key_equal;
+#if defined(DICTCPP_ENABLE_STATS)
+    // Updated by lookups too, which are otherwise `const`
+    mutable StatsRecord<Dict> stats_record{this};
+#endif
+
+    // Types which can be used to look up keys: `Key` itself, or any type accepted by
+    // both `Hash` and `KeyEqual` if they are transparent
+    template<typename K>
+    static constexpr bool is_lookup_key = std::is_same_v<K, Key> || (
+                                              requires {
+                                                  typename Hash::is_transparent;
+                                                  typename KeyEqual::is_transparent;
+                                              }
+                                              && std::is_invocable_r_v<size_t, const Hash &, const K &>
+                                              && std::is_invocable_r_v<bool, const KeyEqual &, const Key &, const K &>);
+
+    // Keys which are found by comparing them directly, rather than comparing hashes first
+    // (the comparison is cheap and cannot branch)
+    template<typename K>
+    static constexpr bool compare_keys_directly = std::is_same_v<K, Key>
+                                                  && (std::is_integral_v<Key> || std::is_enum_v<Key> ||
+                                                      std::is_pointer_v<Key>)
+                                                  && (std::is_same_v<KeyEqual, std::equal_to<> > ||
+                                                      std::is_same_v<KeyEqual, std::equal_to<Key> >);
+
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+    static constexpr size_t dead_hash = npos;
+    static constexpr size_t group_width = simd::Group::width;
+    static constexpr size_t min_table_size = 16;
+    static_assert(min_table_size % group_width == 0);
+
+    template<typename K>
+    size_t hash_key(const K &key) const {
+        const size_t hash = hasher(key);
+        return hash == dead_hash ? hash - 1 : hash;
+    }
+
+    // Update the statistics, if they are enabled, by calling `update` with the counts to add to
+    // them (otherwise nothing is recorded, and `update` is never called)
+    template<typename Update>
+    void record([[maybe_unused]] const Update &update) const {
+#if defined(DICTCPP_ENABLE_STATS)
+        DictStats counts;
+        update(counts);
+        stats_record.add(counts);
+#endif
+    }
+
+    void record_lookup(const size_t index) const {
+        record([&](DictStats &stats) {
+            stats.lookups++;
+            (index == npos ? stats.misses : stats.hits)++;
+        });
+    }
+
+    void record_probe(const size_t groups, const size_t comparisons) const {
+        record([&](DictStats &stats) {
+            stats.probes += groups;
+            stats.max_probe_length = std::max(stats.max_probe_length, groups);
+            stats.key_comparisons += comparisons;
+        });
+    }
+
+    // Bytes of heap storage held by `container`
+    template<typename Container>
+    static size_t heap_bytes(const Container &container) {
+        if constexpr (requires { container.heap_bytes(); }) {
+            return container.heap_bytes();
+        } else {
+            return container.capacity() * sizeof(typename Container::value_type);
+        }
+    }
+
+#if defined(DICTCPP_ENABLE_STATS)
+    std::array<size_t, 5> storage() const {
+        return {heap_bytes(key_list), heap_bytes(val_list), heap_bytes(hash_list), heap_bytes(index_table),
+                heap_bytes(control)};
+    }
+
+    // Records the lists and index reallocated during its lifetime as allocations
+    class AllocationRecord {
+        const Dict *dict;
+        std::array<size_t, 5> before;
+
+    public:
+        explicit AllocationRecord(const Dict *dict) : dict(dict), before(dict->storage()) {
+        }
+
+        ~AllocationRecord() {
+            const auto after = dict->storage();
+            for (size_t i = 0; i < after.size(); ++i) {
+                if (after[i] != before[i] && after[i] != 0) {
+                    dict->record([&](DictStats &stats) {
+                        stats.allocations++;
+                        stats.allocated_bytes += after[i];
+                    });
+                }
+            }
+        }
+    };
+#else
+    struct AllocationRecord {
+        explicit AllocationRecord(const Dict *) {
+        }
+    };
+#endif
+
+    // The table is kept at most two-thirds full (counting deleted slots)
+    static size_t usable_size(const size_t table_size) {
+        return table_size * 2 / 3;
+    }
+
+    static size_t table_size_for(const size_t n) {
+        size_t table_size = min_table_size;
+        while (usable_size(table_size) < n) {
+            table_size <<= 1;
+        }
+        return table_size;
+    }
+
+    bool is_live(const size_t index) const {
+        return hash_list[index] != dead_hash;
+    }
+
+    bool is_small() const {
+        return index_table.empty();
+    }
+
+    // Number of items which can be held before the index is rebuilt (or, for a small
+    // dictionary, before the index is built)
+    size_t index_capacity() const {
+        if (is_small()) {
+            return InlineCapacity;
+        }
+        return usable_size(index_table.size()) - (filled - used);
+    }
+
+    // Position of the first entry of a small dictionary, from `first` on, for which `match`
+    // is true (`npos` if there is none). Entries are tested in blocks of four, setting one bit
+    // of a mask per entry without branching, so that the tests of a block run in parallel.
+    template<typename Match>
+    size_t scan(size_t first, const Match &match) const {
+        constexpr size_t block = 4;
+        const auto n = hash_list.size();
+        for (; first + block <= n; first += block) {
+            unsigned matches = 0;
+            for (size_t i = 0; i < block; ++i) {
+                matches |= static_cast<unsigned>(match(first + i)) << i;
+            }
+            if (matches != 0) {
+                return first + static_cast<size_t>(std::countr_zero(matches));
+            }
+        }
+        for (; first < n; ++first) {
+            if (match(first)) {
+                return first;
+            }
+        }
+        return npos;
+    }
+
+    // Position of `key` in a small dictionary, `npos` if absent, comparing the keys directly
+    template<typename K>
+    size_t scan_keys(const K &key) const {
+        if constexpr (simd::BytewiseComparable<Key>) {
+            const auto index = simd::find(key_list.data(), key_list.size(), key_list.capacity(), key);
+            return index == key_list.size() ? npos : index;
+        } else {
+            return scan(0, [&](const size_t i) { return key_list[i] == key; });
+        }
+    }
+
+    // Position of `key` in a small dictionary, `npos` if absent. Hashes are compared first,
+    // and keys only for entries with matching hashes.
+    template<typename K>
+    size_t scan_hashes(const K &key, const size_t hash) const {
+        const auto hash_matches = [&](const size_t i) { return hash_list[i] == hash; };
+        for (auto index = scan(0, hash_matches); index != npos; index = scan(index + 1, hash_matches)) {
+            record([](DictStats &stats) { stats.key_comparisons++; });
+            if (key_equal(key_list[index], key)) {
+                return index;
+            }
+        }
+        return npos;
+    }
+
+    // Hashes are mixed before use, so that even poor hashes (such as the identity hash of
+    // integers) spread over the table. The low 7 bits of the mixed hash are the fingerprint
+    // kept in the control byte, and the remaining bits select the first group to probe.
+    static size_t mix(size_t hash) {
+        hash *= static_cast<size_t>(0x9E3779B97F4A7C15);
+        return hash ^ (hash >> (std::numeric_limits<size_t>::digits / 2));
+    }
+
+    static int8_t fingerprint(const size_t mixed) {
+        return static_cast<int8_t>(mixed & 0x7F);
+    }
+
+    // Probe sequence over the groups of the table: 1, 2, 3, ... groups on from the first group
+    // (triangular numbers, which visit every group of a power-of-two table)
+    struct Probe {
+        size_t group;
+        size_t mask;
+        size_t step = 0;
+
+        size_t first_slot() const {
+            return group * group_width;
+        }
+
+        void next() {
+            group = (group + ++step) & mask;
+        }
+    };
+
+    Probe probe(const size_t mixed) const {
+        const auto mask = index_table.size() / group_width - 1;
+        return {(mixed >> 7) & mask, mask};
+    }
+
+    // Whether the entry at `index` has the key `key` with hash `hash`
+    template<typename K>
+    bool is_entry(const size_t index, const K &key, const size_t hash) const {
+        if constexpr (compare_keys_directly<K>) {
+            return key_list[index] == key;
+        } else {
+            return hash_list[index] == hash && key_equal(key_list[index], key);
+        }
+    }
+
+    // Position of the entry for `key` in the index, `npos` if absent, adding the number of
+    // groups probed to `groups` and of keys compared to `comparisons`. Probing stops at the
+    // first group with an empty slot.
+    template<typename K>
+    size_t probe_entry(const K &key, const size_t hash, size_t &groups, size_t &comparisons) const {
+        const auto mixed = mix(hash);
+        for (auto sequence = probe(mixed);; sequence.next()) {
+            groups++;
+            const auto first = sequence.first_slot();
+            const simd::Group group(control.data() + first);
+            for (auto matches = group.match(fingerprint(mixed)); matches != 0; matches &= matches - 1) {
+                const auto index = index_table[first + simd::Group::lowest(matches)];
+                comparisons++;
+                if (is_entry(index, key, hash)) {
+                    return index;
+                }
+            }
+            if (group.match_empty() != 0) {
+                return npos;
+            }
+        }
+    }
+
+    template<typename K>
+    size_t find_entry(const K &key, const size_t hash) const {
+        size_t groups = 0;
+        size_t comparisons = 0;
+        const auto index = probe_entry(key, hash, groups, comparisons);
+        record_probe(groups, comparisons);
+        return index;
+    }
+
+    // Returns the slot holding `key` or, if it is absent, the first free (empty or deleted)
+    // slot along its probe sequence, where it would be inserted
+    template<typename K>
+    size_t find_slot(const K &key, const size_t hash) const {
+        const auto mixed = mix(hash);
+        size_t free_slot = npos;
+        size_t groups = 0;
+        size_t comparisons = 0;
+        for (auto sequence = probe(mixed);; sequence.next()) {
+            groups++;
+            const auto first = sequence.first_slot();
+            const simd::Group group(control.data() + first);
+            for (auto matches = group.match(fingerprint(mixed)); matches != 0; matches &= matches - 1) {
+                const auto slot = first + simd::Group::lowest(matches);
+                comparisons++;
+                if (is_entry(index_table[slot], key, hash)) {
+                    record_probe(groups, comparisons);
+                    return slot;
+                }
+            }
+            if (free_slot == npos) {
+                if (const auto free = group.match_free(); free != 0) {
+                    free_slot = first + simd::Group::lowest(free);
+                }
+            }
+            if (group.match_empty() != 0) {
+                record_probe(groups, comparisons);
+                return free_slot;
+            }
+        }
+    }
+
+    // First free (empty or deleted) slot along the probe sequence of `hash`
+    size_t find_free_slot(const size_t hash) const {
+        for (auto sequence = probe(mix(hash));; sequence.next()) {
+            const auto first = sequence.first_slot();
+            if (const auto free = simd::Group(control.data() + first).match_free(); free != 0) {
+                return first + simd::Group::lowest(free);
+            }
+        }
+    }
+
+    // Slot in the index pointing to the (live) entry at `index`
+    size_t slot_of(const size_t index) const {
+        const auto mixed = mix(hash_list[index]);
+        for (auto sequence = probe(mixed);; sequence.next()) {
+            const auto first = sequence.first_slot();
+            const simd::Group group(control.data() + first);
+            for (auto matches = group.match(fingerprint(mixed)); matches != 0; matches &= matches - 1) {
+                const auto slot = first + simd::Group::lowest(matches);
+                if (index_table[slot] == index) {
+                    return slot;
+                }
+            }
+        }
+    }
+
+    // Point the free `slot` at the entry at `index`
+    void fill_slot(const size_t slot, const size_t index) {
+        control[slot] = fingerprint(mix(hash_list[index]));
+        index_table[slot] = index;
+    }
+
+    // Where a key is stored: its `slot` in the index (as returned by `find_slot`, `npos` for a
+    // small dictionary) and the position of its entry (`npos` if the key is absent)
+    struct Location {
+        size_t slot;
+        size_t index;
+    };
+
+    template<typename K>
+    Location locate(const K &key, const size_t hash) const {
+        Location location{npos, npos};
+        if (is_small()) {
+            if constexpr (compare_keys_directly<K>) {
+                location.index = scan_keys(key);
+            } else {
+                location.index = scan_hashes(key, hash);
+            }
+        } else {
+            location.slot = find_slot(key, hash);
+            location.index = control[location.slot] >= 0 ? index_table[location.slot] : npos;
+        }
+        record_lookup(location.index);
+        return location;
+    }
+
+    // Remove all tombstones from the entry lists and rebuild the index with `table_size` slots.
+    // With a `table_size` of zero, the index is dropped (for at most `InlineCapacity` items).
+    // The entries are then preceded by `front` tombstones (at most `used`), into which entries
+    // can be moved to the front without shifting the others.
+    void rebuild(const size_t table_size, const size_t front = 0) {
+        [[maybe_unused]] const AllocationRecord allocations(this);
+        record([&](DictStats &stats) {
+            stats.rebuilds++;
+            stats.growths += table_size > index_table.size();
+        });
+
+        if (used != key_list.size()) {
+            size_t count = 0;
+            for (size_t i = head; i < key_list.size(); ++i) {
+                if (is_live(i)) {
+                    if (i != count) {
+                        key_list[count] = std::move(key_list[i]);
+                        val_list[count] = std::move(val_list[i]);
+                        hash_list[count] = hash_list[i];
+                    }
+                    count++;
+                }
+            }
+            key_list.erase(key_list.begin() + count, key_list.end());
+            val_list.erase(val_list.begin() + count, val_list.end());
+            hash_list.erase(hash_list.begin() + count, hash_list.end());
+            head = 0;
+        }
+        if (front != 0) {
+            add_front(front);
+        }
+
+        if (table_size == 0) {
+            release(index_table);
+            release(control);
+        } else {
+            index_table.assign(table_size, 0);
+            control.assign(table_size, simd::empty_control);
+            for (size_t i = head; i < hash_list.size(); ++i) {
+                fill_slot(find_free_slot(hash_list[i]), i);
+            }
+        }
+        filled = used;
+    }
+
+    // Shift the (compact) entries up by `front` positions, leaving moved-from tombstones before them
+    void add_front(const size_t front) {
+        const auto size = key_list.size();
+        key_list.reserve(size + front);
+        val_list.reserve(size + front);
+        hash_list.reserve(size + front);
+        for (auto i = size - front; i < size; ++i) {
+            key_list.emplace_back(std::move(key_list[i]));
+            val_list.emplace_back(std::move(val_list[i]));
+            hash_list.push_back(hash_list[i]);
+        }
+        for (auto i = size - front; i-- > 0;) {
+            key_list[i + front] = std::move(key_list[i]);
+            val_list[i + front] = std::move(val_list[i]);
+            hash_list[i + front] = hash_list[i];
+        }
+        for (size_t i = 0; i < front; ++i) {
+            hash_list[i] = dead_hash;
+            if constexpr (packed_values) {
+                val_list[i] = false;
+            }
+        }
+        head = front;
+    }
+
+    // Destroy all elements of `list` and free its storage (keeping its allocator)
+    template<typename Container>
+    static void release(Container &container) {
+        container = Container(container.get_allocator());
+    }
+
+    template<typename K>
+    size_t lookup(const K &key) const {
+        size_t index = npos;
+        if (used != 0) {
+            if (!is_small()) {
+                index = find_entry(key, hash_key(key));
+            } else if constexpr (compare_keys_directly<K>) {
+                index = scan_keys(key);
+            } else {
+                index = scan_hashes(key, hash_key(key));
+            }
+        }
+        record_lookup(index);
+        return index;
+    }
+
+    // Append a new entry for a key known not to be in the dictionary, using the free `slot`
+    // returned by `locate`. The value is constructed in place from `args`. Returns the
+    // position of the new entry.
+    template<typename K, typename... Args>
+    size_t insert_at(size_t slot, const size_t hash, K &&key, Args &&... args) {
+        if (is_small()
+                ? used == InlineCapacity
+                : control[slot] == simd::empty_control && usable_size(index_table.size()) <= filled) {
+            // Rebuilding moves the stored values, which `args` may refer to
+            Value value(std::forward<Args>(args)...);
+            rebuild(table_size_for(used + 1));
+            return insert_at(find_free_slot(hash), hash, std::forward<K>(key), std::move(value));
+        }
+
+        [[maybe_unused]] const AllocationRecord allocations(this);
+        val_list.emplace_back(std::forward<Args>(args)...);
+        try {
+            key_list.emplace_back(std::forward<K>(key));
+            try {
+                hash_list.push_back(hash);
+            } catch (...) {
+                key_list.pop_back();
+                throw;
+            }
+        } catch (...) {
+            val_list.pop_back();
+            throw;
+        }
+
+        if (!is_small()) {
+            if (control[slot] == simd::empty_control) {
+                filled++;
+            }
+            fill_slot(slot, key_list.size() - 1);
+        }
+        used++;
+        record([](DictStats &stats) { stats.insertions++; });
+
+        return key_list.size() - 1;
+    }
+
+    // Position of the entry for `key` (inserting a value constructed from `args` if the key is
+    // absent), and whether it was inserted
+    template<typename K, typename... Args>
+    std::pair<size_t, bool> try_emplace_index(K &&key, Args &&... args) {
+        const auto hash = hash_key(key);
+        const auto [slot, index] = locate(key, hash);
+        if (index != npos) {
+            return {index, false};
+        }
+
+        return {insert_at(slot, hash, std::forward<K>(key), std::forward<Args>(args)...), true};
+    }
+
+    template<typename K, typename M>
+    std::pair<size_t, bool> insert_or_assign_index(K &&key, M &&value) {
+        const auto hash = hash_key(key);
+        const auto [slot, index] = locate(key, hash);
+        if (index != npos) {
+            val_list[index] = std::forward<M>(value);
+            return {index, false};
+        }
+
+        return {insert_at(slot, hash, std::forward<K>(key), std::forward<M>(value)), true};
+    }
+
+    // Bulk insertion of `count` items: the storage and index are sized once up front, then the
+    // items are inserted in a single pass. A repeated key keeps the position of its first
+    // occurrence and the value of its last (as in Python).
+    template<typename Iterator>
+    void insert_items(Iterator first, const Iterator last, const size_t count) {
+        reserve(used + count);
+        for (; first != last; ++first) {
+            auto &&kv = *first;
+            insert_or_assign_index(std::forward<decltype(kv)>(kv).key, std::forward<decltype(kv)>(kv).value);
+        }
+    }
+
+    // Ranges of key-value pairs (other than dictionaries of this type, which are ranges of keys)
+    template<typename R>
+    static constexpr bool is_item_range = ItemRange<R> && !std::is_same_v<std::remove_cvref_t<R>, Dict>;
+
+    template<typename K, typename V>
+    void insert_pair(K &&key, V &&value) {
+        if constexpr (std::is_same_v<std::remove_cvref_t<K>, Key>) {
+            insert_or_assign_index(std::forward<K>(key), std::forward<V>(value));
+        } else {
+            insert_or_assign_index(Key(std::forward<K>(key)), std::forward<V>(value));
+        }
+    }
+
+    // Insert the pairs of `range` with a single lookup each, after reserving storage for all of
+    // them if the size of `range` is known (or bounded by its `size_hint()`, as for the lazy
+    // pipelines of dict_ranges.hpp). If `range` is an rvalue container, its keys and values are
+    // moved, and the nodes of a `std::map` or `std::unordered_map` are extracted (leaving it
+    // empty) so that even their `const` keys are moved. Pairs produced as temporaries by a view
+    // are moved too.
+    template<typename R>
+    void insert_range(R &&range) {
+        if constexpr (std::ranges::sized_range<R>) {
+            reserve(used + static_cast<size_t>(std::ranges::size(range)));
+        } else if constexpr (requires { { range.size_hint() } -> std::convertible_to<size_t>; }) {
+            reserve(used + static_cast<size_t>(range.size_hint()));
+        }
+
+        constexpr bool owned = !std::is_lvalue_reference_v<R> && !std::ranges::view<std::remove_cvref_t<R> >;
+        if constexpr (owned && requires { range.extract(range.begin()).key(); }) {
+            while (!range.empty()) {
+                auto node = range.extract(range.begin());
+                insert_pair(std::move(node.key()), std::move(node.mapped()));
+            }
+        } else if constexpr (owned) {
+            for (auto &&item: range) {
+                insert_pair(pair_key(std::move(item)), pair_value(std::move(item)));
+            }
+        } else {
+            for (auto &&item: range) {
+                insert_pair(pair_key(std::forward<decltype(item)>(item)), pair_value(std::forward<decltype(item)>(item)));
+            }
+        }
+    }
+
+    // Minimum number of items for each thread of the parallel bulk operations
+    static constexpr size_t parallel_grain = 1 << 14;
+
+    // Bulk insertion of `count` items, with the same result as inserting `key_at(i)` (whose hash
+    // is `hash_at(i)`) and `value_at(i)` for each `i` in order. The value of a key already present
+    // is replaced, or updated to `combine(value, value_at(i))` unless `combine` is `nullptr`.
+    // `take_key(i)` gives the key to store, and `unique` means that the keys are distinct.
+    // Large insertions are divided between up to `threads` threads by `insert_phased()`.
+    template<typename KeyAt, typename HashAt, typename TakeKey, typename ValueAt, typename Combine = std::nullptr_t>
+    void insert_bulk(const size_t count, const size_t threads, const KeyAt &key_at, const HashAt &hash_at,
+                     const TakeKey &take_key, const ValueAt &value_at, const bool unique, const Combine &combine = nullptr) {
+        if (const auto parts = std::min(threads, count / parallel_grain); parts > 1) {
+            insert_phased(count, parts, key_at, hash_at, take_key, value_at, unique, combine);
+            return;
+        }
+
+        reserve(used + count);
+        for (size_t i = 0; i < count; ++i) {
+            const auto hash = hash_at(i);
+            if (const auto [slot, index] = locate(key_at(i), hash); index != npos) {
+                update_value(val_list[index], value_at(i), combine);
+            } else {
+                insert_at(slot, hash, take_key(i), value_at(i));
+            }
+        }
+    }
+
+    template<typename Target, typename V, typename Combine>
+    static void update_value(Target &&target, V &&value, const Combine &combine) {
+        if constexpr (std::is_null_pointer_v<Combine>) {
+            target = std::forward<V>(value);
+        } else {
+            target = combine(std::as_const(target), std::forward<V>(value));
+        }
+    }
+
+    // `insert_bulk()` in phases: the keys are hashed and looked up on `parts` threads, then
+    // deduplicated on as many threads, and finally a single pass in order appends the new
+    // entries, finding their slots from the hashes without comparing keys, and updates the
+    // other values. If the dictionary is empty, the number of distinct keys is known before
+    // the pass, so the storage and index are allocated once, at their final size.
+    template<typename KeyAt, typename HashAt, typename TakeKey, typename ValueAt, typename Combine>
+    void insert_phased(const size_t count, const size_t parts, const KeyAt &key_at, const HashAt &hash_at,
+                       const TakeKey &take_key, const ValueAt &value_at, const bool unique, const Combine &combine) {
+        if (used != 0) {
+            // Positions found by the lookups must stay valid, so the storage cannot be compacted later
+            reserve(used + count);
+        }
+
+        // Position of the entry of each key already present, `npos` for new keys
+        std::vector<size_t> hashes(count);
+        std::vector<size_t> entries(count, npos);
+        std::vector<DictStats> part_stats(parts);
+        detail::parallel_for(count, parts, [&](const size_t part, const size_t first, const size_t last) {
+            auto &stats = part_stats[part];
+            for (auto i = first; i < last; ++i) {
+                hashes[i] = hash_at(i);
+                if (used != 0) {
+                    size_t groups = 0;
+                    entries[i] = probe_entry(key_at(i), hashes[i], groups, stats.key_comparisons);
+                    stats.probes += groups;
+                    stats.max_probe_length = std::max(stats.max_probe_length, groups);
+                    (entries[i] == npos ? stats.misses : stats.hits)++;
+                    stats.lookups++;
+                }
+            }
+        });
+        record([&](DictStats &stats) {
+            for (const auto &part: part_stats) {
+                stats += part;
+            }
+        });
+
+        // Position of the first occurrence of each new key
+        std::vector<size_t> first_of(count);
+        if (unique) {
+            for (size_t i = 0; i < count; ++i) {
+                first_of[i] = i;
+            }
+        } else {
+            find_first_occurrences(parts, key_at, hashes, entries, first_of);
+        }
+
+        size_t new_keys = 0;
+        for (size_t i = 0; i < count; ++i) {
+            new_keys += entries[i] == npos && first_of[i] == i;
+        }
+        reserve(used + new_keys);
+
+        // Each first occurrence is replaced by the position of its new entry
+        for (size_t i = 0; i < count; ++i) {
+            if (entries[i] != npos) {
+                update_value(val_list[entries[i]], value_at(i), combine);
+            } else if (first_of[i] == i) {
+                const auto slot = is_small() ? npos : find_free_slot(hashes[i]);
+                first_of[i] = insert_at(slot, hashes[i], take_key(i), value_at(i));
+            } else {
+                update_value(val_list[first_of[first_of[i]]], value_at(i), combine);
+            }
+        }
+    }
+
+    // Set `first_of[i]` to the position of the first occurrence of `key_at(i)`, for the new keys
+    // (with no entry). The keys are divided into small buckets by hash, which are divided between
+    // `parts` threads. Each bucket is sorted by hash, so that only keys with equal hashes are compared.
+    template<typename KeyAt>
+    void find_first_occurrences(const size_t parts, const KeyAt &key_at, const std::vector<size_t> &hashes,
+                                const std::vector<size_t> &entries, std::vector<size_t> &first_of) const {
+        const auto count = hashes.size();
+        const auto buckets = std::max(parts, count / 1024);
+        const auto bucket_of = [&](const size_t i) {
+            return mix(hashes[i]) % buckets;
+        };
+
+        // Positions of the keys of each bucket, in order, from the counts of each bucket in each part
+        std::vector<size_t> offsets(parts * buckets);
+        detail::parallel_for(count, parts, [&](const size_t part, const size_t first, const size_t last) {
+            for (auto i = first; i < last; ++i) {
+                if (entries[i] == npos) {
+                    offsets[part * buckets + bucket_of(i)]++;
+                }
+            }
+        });
+        std::vector<size_t> bucket_starts(buckets + 1);
+        size_t total = 0;
+        for (size_t bucket = 0; bucket < buckets; ++bucket) {
+            bucket_starts[bucket] = total;
+            for (size_t part = 0; part < parts; ++part) {
+                total += std::exchange(offsets[part * buckets + bucket], total);
+            }
+        }
+        bucket_starts[buckets] = total;
+
+        std::vector<size_t> order(total);
+        detail::parallel_for(count, parts, [&](const size_t part, const size_t first, const size_t last) {
+            for (auto i = first; i < last; ++i) {
+                if (entries[i] == npos) {
+                    order[offsets[part * buckets + bucket_of(i)]++] = i;
+                }
+            }
+        });
+
+        detail::parallel_for(buckets, parts, [&](size_t, const size_t first_bucket, const size_t last_bucket) {
+            const auto begin_at = [&](const size_t bucket) {
+                return order.begin() + static_cast<std::ptrdiff_t>(bucket_starts[bucket]);
+            };
+            for (auto bucket = first_bucket; bucket < last_bucket; ++bucket) {
+                const auto begin = begin_at(bucket);
+                const auto end = begin_at(bucket + 1);
+                // Stable, so that keys with equal hashes stay in order
+                std::stable_sort(begin, end, [&](const size_t a, const size_t b) { return hashes[a] < hashes[b]; });
+                for (auto run = begin; run != end;) {
+                    const auto run_end = std::find_if(run, end, [&](const size_t i) { return hashes[i] != hashes[*run]; });
+                    for (auto it = run; it != run_end; ++it) {
+                        first_of[*it] = *it;
+                        for (auto previous = run; previous != it; ++previous) {
+                            if (first_of[*previous] == *previous && key_equal(key_at(*previous), key_at(*it))) {
+                                first_of[*it] = *previous;
+                                break;
+                            }
+                        }
+                    }
+                    run = run_end;
+                }
+            }
+        });
+    }
+
+    // `insert_bulk()` of the live entries of `other`, whose keys are distinct and whose hashes
+    // are reused. `take(list, position)` gives the key or value to insert.
+    template<typename Other, typename Take>
+    void update_parallel(Other &other, const size_t threads, const Take &take) {
+        std::vector<size_t> positions;
+        if (!other.is_compact()) {
+            positions.reserve(other.used);
+            for (auto i = other.head; i < other.key_list.size(); i = other.next_live(i)) {
+                positions.push_back(i);
+            }
+        }
+        const auto position = [&](const size_t i) {
+            return positions.empty() ? other.head + i : positions[i];
+        };
+
+        insert_bulk(other.used, threads,
+                    [&](const size_t i) -> const Key & { return other.key_list[position(i)]; },
+                    [&](const size_t i) { return other.hash_list[position(i)]; },
+                    [&](const size_t i) -> decltype(auto) { return take(other.key_list, position(i)); },
+                    [&](const size_t i) -> decltype(auto) { return take(other.val_list, position(i)); }, true);
+    }
 
-    bool key_exists(const Key &key) const {
-        return std::set<Key>(key_list.begin(), key_list.end()).contains(key);
+    // Delete the entry at `location`. In a small dictionary, the following entries are moved
+    // down. Otherwise a tombstone is left: the entry is released immediately, trailing
+    // tombstones are dropped, and the lists are compacted once more than half of the entries
+    // are dead.
+    void erase_at(const Location location) {
+        const auto [slot, index] = location;
+        record([](DictStats &stats) { stats.deletions++; });
+        if (is_small()) {
+            key_list.erase(key_list.begin() + static_cast<std::ptrdiff_t>(index));
+            val_list.erase(val_list.begin() + static_cast<std::ptrdiff_t>(index));
+            hash_list.erase(hash_list.begin() + static_cast<std::ptrdiff_t>(index));
+            used--;
+            return;
+        }
+
+        // Probing stops at the first group with an empty slot, so if the group of `slot` has
+        // one, no probe sequence continues past it and `slot` can be emptied
+        if (simd::Group(control.data() + slot / group_width * group_width).match_empty() != 0) {
+            control[slot] = simd::empty_control;
+            filled--;
+        } else {
+            control[slot] = simd::deleted_control;
+        }
+        hash_list[index] = dead_hash;
+        {
+            [[maybe_unused]] const Key key = std::move(key_list[index]);
+            [[maybe_unused]] const Value value = std::move(val_list[index]);
+        }
+        if constexpr (packed_values) {
+            // Deleted entries are kept `false`, so that the values can be counted a word at a time
+            val_list[index] = false;
+        }
+        used--;
+
+        while (!hash_list.empty() && !is_live(hash_list.size() - 1)) {
+            key_list.pop_back();
+            val_list.pop_back();
+            hash_list.pop_back();
+        }
+        if (used == 0) {
+            head = 0;
+            return;
+        }
+        while (!is_live(head)) {
+            head++;
+        }
+
+        if (key_list.size() - used > used) {
+            rebuild(used <= InlineCapacity ? 0 : index_table.size());
+        }
+    }
+
+    // Move the entry at position `from` to position `to`, shifting the entries between them by
+    // one towards `from`
+    void shift_entry(const size_t from, const size_t to) {
+        Key key = std::move(key_list[from]);
+        Value value = std::move(val_list[from]);
+        const auto hash = hash_list[from];
+        for (auto i = from; i < to; ++i) {
+            key_list[i] = std::move(key_list[i + 1]);
+            val_list[i] = std::move(val_list[i + 1]);
+            hash_list[i] = hash_list[i + 1];
+        }
+        for (auto i = from; i > to; --i) {
+            key_list[i] = std::move(key_list[i - 1]);
+            val_list[i] = std::move(val_list[i - 1]);
+            hash_list[i] = hash_list[i - 1];
+        }
+        key_list[to] = std::move(key);
+        val_list[to] = std::move(value);
+        hash_list[to] = hash;
     }
 
-    size_t get_index(const Key &key) const {
-        for (size_t i = 0; i < key_list.size(); i++) {
-            if (key_list[i] == key) {
-                return i;
+    // Move the entry at `location` to the end of the entries (or the front, if `last` is false),
+    // returning its new position. In a small dictionary the entries in between are shifted.
+    // Otherwise the entry is appended, leaving a tombstone, or moved into the tombstone before
+    // `head`. Moving to the front with no such tombstone shifts the entries and rebuilds the
+    // index, leaving half as many tombstones as items before `head` for the following moves, so
+    // that moves are amortised constant time.
+    size_t move_entry(const Location location, const bool last) {
+        const auto [slot, index] = location;
+        const auto target = last ? key_list.size() - 1 : head;
+        if (index == target) {
+            return index;
+        }
+        if (is_small()) {
+            shift_entry(index, target);
+            return target;
+        }
+        if (!last && head == 0) {
+            shift_entry(index, 0);
+            const auto front = std::max<size_t>(used / 2, 1);
+            rebuild(index_table.size(), front);
+            return front;
+        }
+
+        size_t position;
+        if (last) {
+            [[maybe_unused]] const AllocationRecord allocations(this);
+            val_list.emplace_back(std::move(val_list[index]));
+            try {
+                key_list.emplace_back(std::move(key_list[index]));
+                try {
+                    hash_list.push_back(hash_list[index]);
+                } catch (...) {
+                    key_list[index] = std::move(key_list.back());
+                    key_list.pop_back();
+                    throw;
+                }
+            } catch (...) {
+                val_list[index] = std::move(val_list.back());
+                val_list.pop_back();
+                throw;
             }
+            position = key_list.size() - 1;
+        } else {
+            position = --head;
+            key_list[position] = std::move(key_list[index]);
+            val_list[position] = std::move(val_list[index]);
+            hash_list[position] = hash_list[index];
+        }
+
+        index_table[slot] = position;
+        hash_list[index] = dead_hash;
+        if constexpr (packed_values) {
+            val_list[index] = false;
+        }
+        while (!is_live(hash_list.size() - 1)) {
+            key_list.pop_back();
+            val_list.pop_back();
+            hash_list.pop_back();
+        }
+        while (!is_live(head)) {
+            head++;
+        }
+
+        if (key_list.size() - used > used) {
+            rebuild(index_table.size());
+            return last ? used - 1 : 0;
+        }
+        return position;
+    }
+
+    size_t next_live(size_t index) const {
+        do {
+            index++;
+        } while (index < hash_list.size() && !is_live(index));
+        return index;
+    }
+
+    size_t previous_live(size_t index) const {
+        do {
+            index--;
+        } while (!is_live(index));
+        return index;
+    }
+
+    template<typename DictType, typename Access>
+    friend class DictIterator;
+
+    template<typename DictType, typename Access>
+    friend class DictView;
+
+    template<typename K, typename V, typename H, typename E>
+    friend class LruDict;
+
+    template<typename K, typename V, typename H, typename E>
+    friend class ConcurrentDict;
+
+    struct KeyAccess {
+        // Key views support the operations of sets
+        static constexpr bool set_like = true;
+
+        static const Key &get(const Dict *dict, const size_t index) {
+            return dict->key_list[index];
+        }
+    };
+
+    struct ValueAccess {
+        template<typename DictType>
+        static decltype(auto) get(DictType *dict, const size_t index) {
+            return dict->val_list[index];
+        }
+    };
+
+    struct ItemAccess {
+        template<typename DictType>
+        static auto get(DictType *dict, const size_t index) {
+            return Item<const Key &, decltype((dict->val_list[index]))>{dict->key_list[index], dict->val_list[index]};
         }
-        throw std::logic_error("`get_index` called but key not in dictionary");
+    };
+
+    bool is_compact() const {
+        return key_list.size() - head == used;
     }
 
+    // Inline entries are moved one by one, which can only throw if the key or value type does
+    // (the hash and comparison functions are moved too)
+    static constexpr bool nothrow_move = (InlineCapacity == 0 || (std::is_nothrow_move_constructible_v<Key> &&
+                                                                   std::is_nothrow_move_constructible_v<Value>))
+                                         && std::is_nothrow_move_constructible_v<Hash>
+                                         && std::is_nothrow_move_assignable_v<Hash>
+                                         && std::is_nothrow_move_constructible_v<KeyEqual>
+                                         && std::is_nothrow_move_assignable_v<KeyEqual>;
+
 public:
+    using allocator_type = Allocator;
+
+    /// Reference to a value: `Value &`, or a `BitReference` for `Dict<Key, bool>`
+    using value_reference = decltype(std::declval<ValueList &>()[0]);
+
+    /// Constant reference to a value: `const Value &`, or a `bool` for `Dict<Key, bool>`
+    using const_value_reference = decltype(std::declval<const ValueList &>()[0]);
+
+    /// Number of items stored inline, without allocating
+    static constexpr size_t inline_capacity = InlineCapacity;
+
+    /// Iterator through the keys of a dictionary. Keys are not modifiable through the iterator,
+    /// as this would invalidate the hash index.
+    using const_iterator = DictIterator<const Dict, KeyAccess>;
+    using iterator = const_iterator;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using reverse_iterator = const_reverse_iterator;
+
+    /// Live view of the dictionary keys, which supports the operations of sets (`&`, `|`, `-`,
+    /// `^`, `isdisjoint()`, subset comparisons...) with other keys
+    using KeysView = DictView<const Dict, KeyAccess>;
+
+    /// Set of keys (a dictionary of packed `bool`s), into which a range of keys is collected
+    /// for the set operations of a `KeysView`
+    using KeySet = Dict<Key, bool, Hash, KeyEqual>;
+
+    /// Live view of the dictionary values
+    ///
+    /// @tparam Const Whether the values are accessed as `const`
+    template<bool Const>
+    using ValuesView = DictView<std::conditional_t<Const, const Dict, Dict>, ValueAccess>;
+
+    /// Live view of the dictionary items, given as `Item`s of references to each key and value
+    ///
+    /// @tparam Const Whether the values are accessed as `const`
+    template<bool Const>
+    using ItemsView = DictView<std::conditional_t<Const, const Dict, Dict>, ItemAccess>;
+
+    /// Iterator through the dictionary items, as returned by `find()`
+    using item_iterator = typename ItemsView<false>::iterator;
+    using const_item_iterator = typename ItemsView<true>::iterator;
+
     /// Initialise an empty dictionary
-    Dict(): key_list({}), val_list({}) {
+    Dict(): Dict(Allocator()) {
+    }
+
+    /// Initialise an empty dictionary using `allocator` for its storage
+    ///
+    /// @param allocator Allocator
+    explicit Dict(const Allocator &allocator) : key_list(AllocatorFor<Key>(allocator)),
+                                                val_list(typename ValueList::allocator_type(allocator)),
+                                                hash_list(AllocatorFor<size_t>(allocator)),
+                                                index_table(AllocatorFor<size_t>(allocator)),
+                                                control(AllocatorFor<int8_t>(allocator)), used(0), filled(0), head(0) {
     }
 
     /// Initialise a dictionary using a list of `Item`s.
     ///
     /// @param key_values A list of dictionary `Item`s (key-value pair)
-    Dict(const std::initializer_list<Item<Key, Value>> &key_values) : key_list(), val_list() {
-        for (const auto &kv: key_values) {
-            if (key_exists(kv.key)) {
-                const auto index = get_index(kv.key);
-                val_list[index] = kv.value;
-            } else {
-                key_list.emplace_back(kv.key);
-                val_list.emplace_back(kv.value);
-            }
-        }
+    /// @param allocator Allocator (default: `Allocator()`)
+    Dict(const std::initializer_list<Item<Key, Value>> &key_values, const Allocator &allocator = Allocator())
+        : Dict(allocator) {
+        insert_items(key_values.begin(), key_values.end(), key_values.size());
     }
 
     /// Initialise a dictionary using a std::vector
     ///
     /// @param key_values Key-value pairs in a vector
-    explicit Dict(const std::vector<Item<Key, Value>> &key_values) {
-        for (const auto &kv: key_values) {
-            if (key_exists(kv.key)) {
-                const auto index = get_index(kv.key);
-                val_list[index] = kv.value;
-            } else {
-                key_list.emplace_back(kv.key);
-                val_list.emplace_back(kv.value);
-            }
+    /// @param allocator Allocator (default: `Allocator()`)
+    explicit Dict(const std::vector<Item<Key, Value>> &key_values, const Allocator &allocator = Allocator())
+        : Dict(allocator) {
+        insert_items(key_values.begin(), key_values.end(), key_values.size());
+    }
+
+    /// Initialise a dictionary by moving the items of a std::vector
+    ///
+    /// @param key_values Key-value pairs in a vector, moved into the dictionary
+    /// @param allocator Allocator (default: `Allocator()`)
+    explicit Dict(std::vector<Item<Key, Value>> &&key_values, const Allocator &allocator = Allocator())
+        : Dict(allocator) {
+        insert_items(std::make_move_iterator(key_values.begin()), std::make_move_iterator(key_values.end()),
+                     key_values.size());
+    }
+
+    /// Initialise a dictionary using a std::vector, hashing and deduplicating the keys on
+    /// several threads. The result is the same as for `Dict(key_values)`.
+    ///
+    /// @param key_values Key-value pairs in a vector
+    /// @param parallel Number of threads
+    /// @param allocator Allocator (default: `Allocator()`)
+    Dict(const std::vector<Item<Key, Value>> &key_values, const Parallel &parallel,
+         const Allocator &allocator = Allocator()) : Dict(allocator) {
+        update(key_values, parallel);
+    }
+
+    /// Initialise a dictionary by moving the items of a std::vector, hashing and deduplicating
+    /// the keys on several threads. The result is the same as for `Dict(std::move(key_values))`.
+    ///
+    /// @param key_values Key-value pairs in a vector, moved into the dictionary
+    /// @param parallel Number of threads
+    /// @param allocator Allocator (default: `Allocator()`)
+    Dict(std::vector<Item<Key, Value>> &&key_values, const Parallel &parallel,
+         const Allocator &allocator = Allocator()) : Dict(allocator) {
+        update(std::move(key_values), parallel);
+    }
+
+    /// Initialise a dictionary using any range of key-value pairs, such as a `std::map`, a
+    /// `std::unordered_map` or a `std::vector` of `std::pair`s, in the order of the range. The
+    /// storage is allocated once if the size of the range is known. The keys and values of an
+    /// rvalue container are moved (the nodes of a `std::map` or `std::unordered_map` are
+    /// extracted, leaving it empty).
+    ///
+    /// @param range Range of `Item`s, `std::pair`s or other tuple-like pairs
+    /// @param allocator Allocator (default: `Allocator()`)
+    template<typename R> requires is_item_range<R>
+    explicit Dict(R &&range, const Allocator &allocator = Allocator()) : Dict(allocator) {
+        insert_range(std::forward<R>(range));
+    }
+
+    Dict(const Dict &other)
+        : Dict(other, std::allocator_traits<Allocator>::select_on_container_copy_construction(other.get_allocator())) {
+    }
+
+    /// Copy a dictionary, using `allocator` for the storage of the copy
+    ///
+    /// @param other Dictionary to copy
+    /// @param allocator Allocator
+    Dict(const Dict &other, const Allocator &allocator) : key_list(other.key_list, AllocatorFor<Key>(allocator)),
+                                                          val_list(other.val_list, typename ValueList::allocator_type(allocator)),
+                                                          hash_list(other.hash_list, AllocatorFor<size_t>(allocator)),
+                                                          index_table(other.index_table,
+                                                                      AllocatorFor<size_t>(allocator)),
+                                                          control(other.control, AllocatorFor<int8_t>(allocator)),
+                                                          used(other.used), filled(other.filled), head(other.head),
+                                                          hasher(other.hasher), key_equal(other.key_equal) {
+    }
+
+    /// Move a dictionary, leaving `other` empty
+    ///
+    /// @param other Dictionary to move from
+    Dict(Dict &&other) noexcept(nothrow_move) : key_list(std::move(other.key_list)), val_list(std::move(other.val_list)),
+                                                 hash_list(std::move(other.hash_list)),
+                                                 index_table(std::move(other.index_table)),
+                                                 control(std::move(other.control)),
+                                                 used(other.used), filled(other.filled), head(other.head),
+                                                 hasher(std::move(other.hasher)),
+                                                 key_equal(std::move(other.key_equal)) {
+        other.clear();
+    }
+
+    /// Move a dictionary, using `allocator` for the storage of the result. If `allocator` differs
+    /// from that of `other`, the items are moved individually. `other` is left empty.
+    ///
+    /// @param other Dictionary to move from
+    /// @param allocator Allocator
+    Dict(Dict &&other, const Allocator &allocator) : Dict(allocator) {
+        if (get_allocator() == other.get_allocator()) {
+            *this = std::move(other);
+        } else {
+            hasher = std::move(other.hasher);
+            key_equal = std::move(other.key_equal);
+            update(std::move(other));
+        }
+    }
+
+    Dict &operator=(const Dict &other) = default;
+
+    /// Move assign a dictionary, leaving `other` empty
+    ///
+    /// @param other Dictionary to move from
+    ///
+    /// @return This dictionary
+    Dict &operator=(Dict &&other) noexcept(nothrow_move) {
+        if (this != &other) {
+            key_list = std::move(other.key_list);
+            val_list = std::move(other.val_list);
+            hash_list = std::move(other.hash_list);
+            index_table = std::move(other.index_table);
+            control = std::move(other.control);
+            used = other.used;
+            filled = other.filled;
+            head = other.head;
+            hasher = std::move(other.hasher);
+            key_equal = std::move(other.key_equal);
+            other.clear();
         }
+        return *this;
+    }
+
+    ~Dict() = default;
+
+    /// Get the allocator of the dictionary
+    ///
+    /// @return Allocator used for the dictionary storage
+    allocator_type get_allocator() const {
+        return allocator_type(key_list.get_allocator());
     }
 
     /// Check if a dictionary is empty
     ///
     /// @return Whether the dictionary is empty or not
     [[nodiscard]] bool empty() const {
-        return key_list.empty();
+        return used == 0;
     }
 
     /// Get the current size of the dictionary
     ///
     /// @return Get the current size of the dictionary (number of keys)
     [[nodiscard]] size_t size() const {
-        return key_list.size();
+        return used;
+    }
+
+    /// Get the number of items the dictionary can hold without reallocating its storage
+    /// or rebuilding its index
+    ///
+    /// @return Capacity of the dictionary
+    [[nodiscard]] size_t capacity() const {
+        const auto list_capacity = key_list.capacity() - (key_list.size() - used);
+        return std::min(index_capacity(), list_capacity);
+    }
+
+    /// Reserve storage for at least `n` items, so that the dictionary can grow to `n` items
+    /// without reallocating its storage or rebuilding its index.
+    ///
+    /// @param n Number of items
+    void reserve(const size_t n) {
+        if (index_capacity() < n) {
+            rebuild(table_size_for(n));
+        }
+
+        [[maybe_unused]] const AllocationRecord allocations(this);
+        const auto dead = key_list.size() - used;
+        key_list.reserve(n + dead);
+        val_list.reserve(n + dead);
+        hash_list.reserve(n + dead);
+    }
+
+    /// Release unused storage: deleted entries are removed and the index is resized to the
+    /// smallest size that holds the current items. If there are at most `inline_capacity`
+    /// items, they are moved back inline.
+    void shrink_to_fit() {
+        if (used == 0) {
+            clear();
+            return;
+        }
+
+        rebuild(used <= InlineCapacity ? 0 : table_size_for(used));
+        [[maybe_unused]] const AllocationRecord allocations(this);
+        key_list.shrink_to_fit();
+        val_list.shrink_to_fit();
+        hash_list.shrink_to_fit();
+        index_table.shrink_to_fit();
+        control.shrink_to_fit();
     }
 
+    /// Get the memory held by the dictionary, compared with the memory it uses: storage is
+    /// also held for spare capacity and for deleted entries not yet removed
+    ///
+    /// @return Bytes allocated and used
+    [[nodiscard]] MemoryUsage memory_usage() const {
+        const auto value_bytes = packed_values ? (used + 7) / 8 : used * sizeof(Value);
+        return {
+            sizeof(Dict) + heap_bytes(key_list) + heap_bytes(val_list) + heap_bytes(hash_list)
+            + heap_bytes(index_table) + heap_bytes(control),
+            used * (sizeof(Key) + sizeof(size_t) + (is_small() ? 0 : sizeof(size_t) + sizeof(int8_t))) + value_bytes
+        };
+    }
+
+#if defined(DICTCPP_ENABLE_STATS)
+    /// Get the statistics of the dictionary since it was created (or the statistics were reset).
+    /// Only available if `DICTCPP_ENABLE_STATS` is defined. The statistics are updated
+    /// atomically, so a dictionary can still be read by several threads at once.
+    ///
+    /// @return Copy of the statistics of the dictionary
+    [[nodiscard]] DictStats stats() const {
+        return stats_record.load();
+    }
+
+    /// Reset the statistics of the dictionary to zero. Only available if `DICTCPP_ENABLE_STATS`
+    /// is defined.
+    void reset_stats() {
+        stats_record.reset();
+    }
+
+    /// Get the statistics of all dictionaries of this type, both live and destroyed. Only
+    /// available if `DICTCPP_ENABLE_STATS` is defined. No dictionary of this type may be
+    /// modified meanwhile.
+    ///
+    /// @return Sum of the statistics
+    static DictStats total_stats() {
+        return StatsRegistry<Dict>::instance().total();
+    }
+
+    /// Call `function` with each live dictionary of this type, for example to find those with
+    /// long probe sequences or much unused memory. Only available if `DICTCPP_ENABLE_STATS`
+    /// is defined. No dictionary of this type may be modified meanwhile, nor created or
+    /// destroyed by `function`.
+    ///
+    /// @param function Function taking a `const Dict &`
+    template<typename Function>
+    static void for_each_instance(Function &&function) {
+        StatsRegistry<Dict>::instance().for_each(std::forward<Function>(function));
+    }
+#endif
+
     /// Access value at key `key`
     ///
     /// @param key Dictionary key
@@ -95,12 +2686,8 @@ public:
     /// @throws std::out_of_range If key not in dictionary
     ///
     /// @return Constant reference to value at `dict[key]`
-    const Value &operator[](const Key &key) const {
-        if (!key_exists(key)) {
-            throw std::out_of_range("Key not found in dictionary");
-        }
-
-        return val_list[get_index(key)];
+    const_value_reference operator[](const Key &key) const {
+        return at<Key>(key);
     }
 
     /// Access value at `key` (wrapper to `operator[] const`)
@@ -108,8 +2695,38 @@ public:
     /// @param key Dictionary key
     ///
     /// @return Constant reference to value at `dict[key]`
-    const Value &at(const Key &key) const {
-        return operator[](key);
+    const_value_reference at(const Key &key) const {
+        return at<Key>(key);
+    }
+
+    /// Access value at key `key`, where `key` is any type which can be compared with
+    /// the dictionary keys (heterogeneous lookup).
+    ///
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @throws std::out_of_range If key not in dictionary
+    ///
+    /// @return Constant reference to value at `dict[key]`
+    template<typename K> requires is_lookup_key<K>
+    const_value_reference operator[](const K &key) const {
+        return at<K>(key);
+    }
+
+    /// Access value at `key` with heterogeneous lookup (wrapper to `operator[] const`)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @throws std::out_of_range If key not in dictionary
+    ///
+    /// @return Constant reference to value at `dict[key]`
+    template<typename K> requires is_lookup_key<K>
+    const_value_reference at(const K &key) const {
+        const auto index = lookup(key);
+        if (index == npos) {
+            throw std::out_of_range("Key not found in dictionary");
+        }
+
+        return val_list[index];
     }
 
     /// Access the value at key `key` or assign value to key `key`
@@ -117,17 +2734,29 @@ public:
     /// @param key Dictionary key
     ///
     /// @return Reference to value at `dict[key]`
-    Value &operator[](const Key &key) {
-        if (key_exists(key)) {
-            const auto index = get_index(key);
-
-            return val_list[index];
-        }
+    value_reference operator[](const Key &key) {
+        return val_list[try_emplace_index(key).first];
+    }
 
-        key_list.push_back(key);
-        val_list.push_back({});
+    /// Access the value at key `key` or assign value to key `key`, moving the key
+    /// into the dictionary if it is inserted
+    ///
+    /// @param key Dictionary key
+    ///
+    /// @return Reference to value at `dict[key]`
+    value_reference operator[](Key &&key) {
+        return val_list[try_emplace_index(std::move(key)).first];
+    }
 
-        return *(std::end(val_list) - 1);
+    /// Access the value at key `key` or assign value to key `key` with heterogeneous lookup.
+    /// A `Key` is only constructed from `key` if it is inserted.
+    ///
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @return Reference to value at `dict[key]`
+    template<typename K> requires is_lookup_key<K> && std::is_constructible_v<Key, const K &>
+    value_reference operator[](const K &key) {
+        return val_list[try_emplace_index(key).first];
     }
 
     /// Access value at `key` or assign value at `key` (wrapper for `operator[]`)
@@ -135,106 +2764,331 @@ public:
     /// @param key Dictionary key
     ///
     /// @return Reference to value at `dict[key]`
-    Value &at(const Key &key) {
+    value_reference at(const Key &key) {
         return operator[](key);
     }
 
-    /// Get the dictionary keys
+    /// Access value at `key` or assign value at `key` with heterogeneous lookup
+    /// (wrapper for `operator[]`)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @return Reference to value at `dict[key]`
+    template<typename K> requires is_lookup_key<K> && std::is_constructible_v<Key, const K &>
+    value_reference at(const K &key) {
+        return operator[]<K>(key);
+    }
+
+    /// Find the item with key `key`
+    ///
+    /// @param key Dictionary key
+    ///
+    /// @return Iterator to the item, or `items().end()` if the key is not in the dictionary
+    item_iterator find(const Key &key) {
+        return find<Key>(key);
+    }
+
+    /// Find the item with key `key`
+    ///
+    /// @param key Dictionary key
+    ///
+    /// @return Iterator to the (`const`) item, or `items().end()` if the key is not in the dictionary
+    const_item_iterator find(const Key &key) const {
+        return find<Key>(key);
+    }
+
+    /// Find the item with key `key` (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @return Iterator to the item, or `items().end()` if the key is not in the dictionary
+    template<typename K> requires is_lookup_key<K>
+    item_iterator find(const K &key) {
+        const auto index = lookup(key);
+        return {this, index == npos ? key_list.size() : index};
+    }
+
+    /// Find the item with key `key` (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @return Iterator to the (`const`) item, or `items().end()` if the key is not in the dictionary
+    template<typename K> requires is_lookup_key<K>
+    const_item_iterator find(const K &key) const {
+        const auto index = lookup(key);
+        return {this, index == npos ? key_list.size() : index};
+    }
+
+    /// If `key` is not in the dictionary, insert it with a value constructed in place
+    /// from `args`. Otherwise, the dictionary is unchanged (and `args` are not used).
+    ///
+    /// @param key Dictionary key
+    /// @param args Arguments to construct the value
+    ///
+    /// @return Iterator to the item with key `key`, and whether it was inserted
+    template<typename... Args>
+    std::pair<item_iterator, bool> try_emplace(const Key &key, Args &&... args) {
+        const auto [index, inserted] = try_emplace_index(key, std::forward<Args>(args)...);
+        return {item_iterator(this, index), inserted};
+    }
+
+    /// If `key` is not in the dictionary, insert it (moving the key) with a value constructed
+    /// in place from `args`. Otherwise, the dictionary is unchanged.
+    ///
+    /// @param key Dictionary key
+    /// @param args Arguments to construct the value
+    ///
+    /// @return Iterator to the item with key `key`, and whether it was inserted
+    template<typename... Args>
+    std::pair<item_iterator, bool> try_emplace(Key &&key, Args &&... args) {
+        const auto [index, inserted] = try_emplace_index(std::move(key), std::forward<Args>(args)...);
+        return {item_iterator(this, index), inserted};
+    }
+
+    /// Assign `value` to `key`, inserting the key if it is not in the dictionary
+    /// (equivalent to `dict[key] = value`, without default-constructing a new value)
+    ///
+    /// @param key Dictionary key
+    /// @param value New value
+    ///
+    /// @return Iterator to the item with key `key`, and whether it was inserted
+    template<typename M>
+    std::pair<item_iterator, bool> insert_or_assign(const Key &key, M &&value) {
+        const auto [index, inserted] = insert_or_assign_index(key, std::forward<M>(value));
+        return {item_iterator(this, index), inserted};
+    }
+
+    /// Assign `value` to `key`, inserting the key (by moving it) if it is not in the dictionary
+    ///
+    /// @param key Dictionary key
+    /// @param value New value
+    ///
+    /// @return Iterator to the item with key `key`, and whether it was inserted
+    template<typename M>
+    std::pair<item_iterator, bool> insert_or_assign(Key &&key, M &&value) {
+        const auto [index, inserted] = insert_or_assign_index(std::move(key), std::forward<M>(value));
+        return {item_iterator(this, index), inserted};
+    }
+
+    /// Construct an `Item` from `args` and insert it if its key is not in the dictionary.
+    /// Otherwise, the dictionary is unchanged.
+    ///
+    /// @param args Arguments to construct an `Item<Key, Value>` (usually a key and a value)
+    ///
+    /// @return Iterator to the item with the constructed key, and whether it was inserted
+    template<typename... Args>
+    std::pair<item_iterator, bool> emplace(Args &&... args) {
+        Item<Key, Value> item(std::forward<Args>(args)...);
+        return try_emplace(std::move(item.key), std::move(item.value));
+    }
+
+    /// Get a view of the dictionary keys
+    ///
+    /// @return Live view of the dictionary keys
+    KeysView keys() const {
+        return KeysView(this);
+    }
+
+    /// Get a view of the dictionary values
+    ///
+    /// @return Live view of the dictionary values
+    ValuesView<true> values() const {
+        return ValuesView<true>(this);
+    }
+
+    /// Get a (modifiable) view of the dictionary values
+    ///
+    /// @return Live view of the dictionary values
+    ValuesView<false> values() {
+        return ValuesView<false>(this);
+    }
+
+    /// Get a view of the dictionary items. Each item is an `Item` holding references to the
+    /// key and value in the dictionary.
+    ///
+    /// @return Live view of the dictionary items (key-value pairs)
+    ItemsView<true> items() const {
+        return ItemsView<true>(this);
+    }
+
+    /// Get a view of the dictionary items, through which values can be modified
+    ///
+    /// @return Live view of the dictionary items (key-value pairs)
+    ItemsView<false> items() {
+        return ItemsView<false>(this);
+    }
+
+    /// Returns an iterator for iterating through the dictionary.
+    /// The iterator points to the first key in the dictionary, so that the keys are
+    /// looped through in insertion order.
+    ///
+    /// @return Iterator pointing to the first key of the dictionary
+    const_iterator begin() const {
+        return {this, head};
+    }
+
+    /// Return an iterator pointing to the end of the dictionary
+    ///
+    /// @return Iterator pointing past the last key of the dictionary
+    const_iterator end() const {
+        return {this, key_list.size()};
+    }
+
+    /// Return a reverse iterator pointing to the last key of the dictionary, so that the keys
+    /// are looped through from the most recently inserted (as Python's `reversed(dict)`). The
+    /// views can be reversed with `std::views::reverse`.
+    ///
+    /// @return Reverse iterator pointing to the last key of the dictionary
+    const_reverse_iterator rbegin() const {
+        return const_reverse_iterator(end());
+    }
+
+    /// Return a reverse iterator pointing before the first key of the dictionary
+    ///
+    /// @return Reverse iterator pointing before the first key of the dictionary
+    const_reverse_iterator rend() const {
+        return const_reverse_iterator(begin());
+    }
+
+    /// Move an existing key to the end of the dictionary, or to the front if `last` is false (as
+    /// Python's `OrderedDict.move_to_end()`). Moving to the end takes constant (amortised) time,
+    /// as does moving to the front after items have been removed from the front (e.g. by
+    /// `popitem(false)`); otherwise moving to the front takes linear time.
+    ///
+    /// @param key Dictionary key
+    /// @param last Whether to move the key to the end (default: `true`) or the front
+    ///
+    /// @throws std::out_of_range If key not in dictionary
+    void move_to_end(const Key &key, const bool last = true) {
+        move_to_end<Key>(key, last);
+    }
+
+    /// Move an existing key to the end or the front of the dictionary (heterogeneous lookup)
     ///
-    /// @return Vector of dictionary keys
-    std::vector<Key> keys() const {
-        // TODO Make a keys, values, and items a "View"
-        return key_list;
+    /// @param key Value comparable with the dictionary keys
+    /// @param last Whether to move the key to the end (default: `true`) or the front
+    ///
+    /// @throws std::out_of_range If key not in dictionary
+    template<typename K> requires is_lookup_key<K>
+    void move_to_end(const K &key, const bool last = true) {
+        const auto location = locate(key, hash_key(key));
+        if (location.index == npos) {
+            throw std::out_of_range("Key not found in dictionary");
+        }
+
+        move_entry(location, last);
     }
 
-    /// Get the dictionary values
+    /// Remove key from dictionary. The entry is marked as deleted (so that no other entries
+    /// are moved) and the storage is compacted once deleted entries outnumber live ones.
     ///
-    /// @return Vector of dictionary values
-    std::vector<Value> values() const {
-        return val_list;
+    /// @throws std::out_of_range If key not in dictionary
+    void del(const Key &key) {
+        del<Key>(key);
     }
 
-    /// Get the dictionary items as a `std::vector`
+    /// Remove key from dictionary (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
     ///
-    /// @return Vector of dictionary items (key-value pairs)
-    std::vector<Item<Key, Value>> items() const {
-        std::vector<Item<Key, Value>> item_list;
-        for (int i = 0; i < key_list.size(); ++i) {
-            item_list.emplace_back(key_list[i], val_list[i]);
+    /// @throws std::out_of_range If key not in dictionary
+    template<typename K> requires is_lookup_key<K>
+    void del(const K &key) {
+        const auto location = locate(key, hash_key(key));
+        if (location.index == npos) {
+            throw std::out_of_range("Key not found in dictionary");
         }
 
-        return item_list;
+        erase_at(location);
     }
 
-    /// Returns an iterator for iterating through the dictionary.
-    /// The iterator point to the beginning of the `key_list`, so that this is
-    /// looped through.
-    ///
-    /// @return Iterator pointing to the beginning of the `key_list`
-    auto begin() {
-        return key_list.begin();
+    /// Remove all deleted entries from the dictionary storage, moving the remaining entries
+    /// to the front in insertion order. This is done automatically once more than half of
+    /// the entries are deleted, so is only needed to release deleted entries early.
+    /// Invalidates all iterators.
+    void compact() {
+        if (used != key_list.size()) {
+            rebuild(used <= InlineCapacity ? 0 : index_table.size());
+        }
     }
 
-    /// Returns an iterator for iterating through a `const` dictionary.
+    /// Check if dictionary contains `key`
+    ///
+    /// @param key A possible key
     ///
-    /// @return Iterator pointing to the `const` key at the beginning of `key_list`
-    auto begin() const {
-        return key_list.begin();
+    /// @return Whether key is present in dictionary
+    bool contains(const Key &key) const {
+        return lookup(key) != npos;
     }
 
-    /// Returns a (non-const) iterator pointing to the end of the dictionary
+    /// Check if dictionary contains `key` (heterogeneous lookup)
     ///
-    /// @return Iterator pointing to the end of the `key_list`
-    auto end() {
-        return key_list.end();
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @return Whether key is present in dictionary
+    template<typename K> requires is_lookup_key<K>
+    bool contains(const K &key) const {
+        return lookup(key) != npos;
     }
 
-    /// Return a (const) iterator pointing to the end of the dictionary
+    /// Count the values which are `true` (for `Dict<Key, bool>`, whose values are packed into
+    /// bits, so that they are counted 64 at a time)
     ///
-    /// @return Iterator pointing to the end of the `const key_list`
-   auto end() const {
-        return key_list.end();
+    /// @return Number of `true` values
+    [[nodiscard]] size_t count() const requires packed_values {
+        return val_list.popcount();
     }
 
-    // TODO Implement reversed
-
-    /// Remove key from dictionary
+    /// Check if all values are `true` (for `Dict<Key, bool>`)
     ///
-    /// @throws std::out_of_range If key not in dictionary
-    void del(const Key &key) {
-        if (!contains(key)) {
-            throw std::out_of_range("Key not found in dictionary");
-        }
-
-        const auto index = get_index(key);
-
-        key_list.erase(key_list.begin() + index);
-        val_list.erase(val_list.begin() + index);
+    /// @return Whether all values are `true` (also for an empty dictionary)
+    [[nodiscard]] bool all() const requires packed_values {
+        return count() == used;
     }
 
-    /// Check if dictionary contains `key`
+    /// Check if any value is `true` (for `Dict<Key, bool>`)
     ///
-    /// @param key A possible key
+    /// @return Whether any value is `true`
+    [[nodiscard]] bool any() const requires packed_values {
+        return val_list.any();
+    }
+
+    /// Check if no value is `true` (for `Dict<Key, bool>`)
     ///
-    /// @return Whether key is present in dictionary
-    bool contains(const Key &key) const {
-        return key_exists(key);
+    /// @return Whether all values are `false` (also for an empty dictionary)
+    [[nodiscard]] bool none() const requires packed_values {
+        return !any();
+    }
+
+    /// Negate all values (for `Dict<Key, bool>`), 64 at a time
+    void flip() requires packed_values {
+        val_list.flip();
+        if (used != key_list.size()) {
+            for (size_t i = 0; i < key_list.size(); ++i) {
+                if (!is_live(i)) {
+                    val_list[i] = false;
+                }
+            }
+        }
     }
 
     /// Remove all items from the dictionary
     void clear() {
-        key_list = {};
-        val_list = {};
+        release(key_list);
+        release(val_list);
+        release(hash_list);
+        release(index_table);
+        release(control);
+        used = 0;
+        filled = 0;
+        head = 0;
     }
 
-    /// Creates a copy of the dictionary
+    /// Creates a copy of the dictionary, using the same allocator
     ///
     /// @return Exact copy of the dictionary
     Dict copy() const {
-        auto new_dict = Dict();
-        new_dict.key_list = key_list;
-        new_dict.val_list = val_list;
-        return new_dict;
+        return Dict(*this, get_allocator());
     }
 
     /// Get value from dictionary at key `key`
@@ -248,9 +3102,22 @@ public:
     ///
     /// @return Value at key, if present, default value otherwise
     Value get(const Key &key, const std::optional<Value> &default_value = std::nullopt) const {
-        if (key_exists(key)) {
-            const auto idx = get_index(key);
-            return val_list[idx];
+        return get<Key>(key, default_value);
+    }
+
+    /// Get value from dictionary at key `key` (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    /// @param default_value Optional default (default: `std::nullopt`)
+    ///
+    /// @throws std::runtime_error If key not in dictionary and no default value is specified
+    ///
+    /// @return Value at key, if present, default value otherwise
+    template<typename K> requires is_lookup_key<K>
+    Value get(const K &key, const std::optional<Value> &default_value = std::nullopt) const {
+        const auto index = lookup(key);
+        if (index != npos) {
+            return val_list[index];
         }
 
         if (!default_value) {
@@ -262,6 +3129,7 @@ public:
 
     /// If the key is in the dictionary, remove it and return its value, else return the
     /// default value. If no default value is given, an error is thrown.
+    /// The value is moved out of the dictionary (and the default value moved into the result).
     ///
     /// @param key The dictionary key
     /// @param default_value Optional default value (default: `std::nullopt`)
@@ -269,12 +3137,26 @@ public:
     /// @throws std::runtime_error If key not in dictionary and no default value
     ///
     /// @return Value at key in dictionary if it exists, otherwise the default.
-    Value pop(const Key &key, const std::optional<Value> &default_value = std::nullopt) {
-        if (key_exists(key)) {
-            const auto idx = get_index(key);
-            const auto value = val_list[idx];
+    Value pop(const Key &key, std::optional<Value> default_value = std::nullopt) {
+        return pop<Key>(key, std::move(default_value));
+    }
+
+    /// Remove key from the dictionary and return its value, else return the default value
+    /// (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    /// @param default_value Optional default value (default: `std::nullopt`)
+    ///
+    /// @throws std::runtime_error If key not in dictionary and no default value
+    ///
+    /// @return Value at key in dictionary if it exists, otherwise the default.
+    template<typename K> requires is_lookup_key<K>
+    Value pop(const K &key, std::optional<Value> default_value = std::nullopt) {
+        const auto location = locate(key, hash_key(key));
+        if (location.index != npos) {
+            Value value = std::move(val_list[location.index]);
 
-            del(key);
+            erase_at(location);
 
             return value;
         }
@@ -283,22 +3165,28 @@ public:
             throw std::runtime_error("Key not found in dictionary and no default exists");
         }
 
-        return default_value.value();
+        return std::move(*default_value);
     }
 
-    /// Remove and return the last key-value pair from the dictionary.
+    /// Remove and return the last key-value pair from the dictionary, or the first if `last`
+    /// is false (as Python's `OrderedDict.popitem()`), in constant (amortised) time.
+    /// The key and value are moved out of the dictionary.
+    ///
+    /// @param last Whether to remove the last item (default: `true`) or the first
     ///
     /// @throws std::out_of_range If dictionary is empty
     ///
     /// @return Key-value pair
-    Item<Key, Value> popitem() {
+    Item<Key, Value> popitem(const bool last = true) {
         if (empty()) {
             throw std::out_of_range("Dictionary is empty, no items to pop!");
         }
-        const auto key = key_list.back();
-        const auto value = pop(key);
+        const auto index = last ? key_list.size() - 1 : head;
+        const auto slot = is_small() ? npos : slot_of(index);
+        Item<Key, Value> item{std::move(key_list[index]), std::move(val_list[index])};
+        erase_at({slot, index});
 
-        return {key, value};
+        return item;
     }
 
     /// If key is in the dictionary, return its value.
@@ -309,45 +3197,252 @@ public:
     /// @param key Dictionary key
     /// @param default_value Default value to be used (default: `std::nullopt`)
     ///
-    /// @return Value at key or default.
-    Value setdefault(const Key &key, const std::optional<Value> &default_value = std::nullopt) {
-        if (key_exists(key)) {
-            return at(key);
-        }
-
+    /// @return Reference to the value at key
+    value_reference setdefault(const Key &key, std::optional<Value> default_value = std::nullopt) {
+        return setdefault<Key>(key, std::move(default_value));
+    }
 
-        key_list.emplace_back(key);
-        const Value value = default_value ? default_value.value() : Value();
-        val_list.emplace_back(value);
+    /// If key is in the dictionary, return its value. Otherwise, insert key (constructing a `Key`
+    /// from `key`) with value of `default_value` and return it (heterogeneous lookup).
+    ///
+    /// @param key Value comparable with the dictionary keys
+    /// @param default_value Default value to be used (default: `std::nullopt`)
+    ///
+    /// @return Reference to the value at key
+    template<typename K> requires is_lookup_key<K> && std::is_constructible_v<Key, const K &>
+    value_reference setdefault(const K &key, std::optional<Value> default_value = std::nullopt) {
+        const auto index = default_value
+                               ? try_emplace_index(key, std::move(*default_value)).first
+                               : try_emplace_index(key).first;
 
-        return value;
+        return val_list[index];
     }
 
     /// Updates the dictionary with key/value pairs from `other`.
     ///
     /// @param other Another dictionary
     void update(const Dict &other) {
-        for (const auto &[k, v]: other.items()) {
-            at(k) = v;
+        if (&other == this) {
+            return;
+        }
+
+        const auto view = other.items();
+        insert_items(view.begin(), view.end(), other.size());
+    }
+
+    /// Updates the dictionary with key/value pairs moved from `other`, which is left empty.
+    ///
+    /// @param other Another dictionary
+    void update(Dict &&other) {
+        if (&other == this) {
+            return;
         }
+
+        reserve(used + other.size());
+        for (auto i = other.head; i < other.key_list.size(); i = other.next_live(i)) {
+            insert_or_assign_index(std::move(other.key_list[i]), std::move(other.val_list[i]));
+        }
+        other.clear();
     }
 
     /// Updates the dictionary with key/value pairs from a list
     ///
     /// @param pairs A list of key-value pairs
     void update(const std::initializer_list<Item<Key, Value>> &pairs) {
-        for (const auto &[k, v]: pairs) {
-            at(k) = v;
-        }
+        insert_items(pairs.begin(), pairs.end(), pairs.size());
     }
 
     /// Updates the dictionary with key/value pairs from a vector
     ///
     /// @param pairs A list of key-value pairs
     void update(const std::vector<Item<Key, Value>> &pairs) {
-        for (const auto &[k, v]: pairs) {
-            at(k) = v;
+        insert_items(pairs.begin(), pairs.end(), pairs.size());
+    }
+
+    /// Updates the dictionary with key/value pairs moved from a vector
+    ///
+    /// @param pairs A list of key-value pairs
+    void update(std::vector<Item<Key, Value>> &&pairs) {
+        insert_items(std::make_move_iterator(pairs.begin()), std::make_move_iterator(pairs.end()), pairs.size());
+    }
+
+    /// Updates the dictionary with the pairs of any range, such as a `std::map`, a
+    /// `std::unordered_map` or a `std::vector` of `std::pair`s. The keys and values of an rvalue
+    /// container are moved (the nodes of a `std::map` or `std::unordered_map` are extracted,
+    /// leaving it empty).
+    ///
+    /// @param range Range of `Item`s, `std::pair`s or other tuple-like pairs
+    template<typename R> requires is_item_range<R>
+    void update(R &&range) {
+        insert_range(std::forward<R>(range));
+    }
+
+    /// Updates the dictionary with key/value pairs from `other`, looking up the keys on
+    /// several threads. The result is the same as for `update(other)`.
+    ///
+    /// @param other Another dictionary
+    /// @param parallel Number of threads
+    void update(const Dict &other, const Parallel &parallel) {
+        if (&other == this) {
+            return;
+        }
+
+        update_parallel(other, parallel.threads, [](const auto &list, const size_t i) -> decltype(auto) {
+            return list[i];
+        });
+    }
+
+    /// Updates the dictionary with key/value pairs moved from `other`, which is left empty,
+    /// looking up the keys on several threads. The result is the same as for
+    /// `update(std::move(other))`.
+    ///
+    /// @param other Another dictionary
+    /// @param parallel Number of threads
+    void update(Dict &&other, const Parallel &parallel) {
+        if (&other == this) {
+            return;
+        }
+
+        update_parallel(other, parallel.threads, [](auto &list, const size_t i) -> decltype(auto) {
+            return std::move(list[i]);
+        });
+        other.clear();
+    }
+
+    /// Updates the dictionary with key/value pairs from a vector, hashing, looking up and
+    /// deduplicating the keys on several threads. The result is the same as for `update(pairs)`.
+    ///
+    /// @param pairs A list of key-value pairs
+    /// @param parallel Number of threads
+    void update(const std::vector<Item<Key, Value>> &pairs, const Parallel &parallel) {
+        insert_bulk(pairs.size(), parallel.threads,
+                    [&](const size_t i) -> const Key & { return pairs[i].key; },
+                    [&](const size_t i) { return hash_key(pairs[i].key); },
+                    [&](const size_t i) -> const Key & { return pairs[i].key; },
+                    [&](const size_t i) -> const Value & { return pairs[i].value; }, false);
+    }
+
+    /// Updates the dictionary with key/value pairs moved from a vector, hashing, looking up and
+    /// deduplicating the keys on several threads. The result is the same as for
+    /// `update(std::move(pairs))`.
+    ///
+    /// @param pairs A list of key-value pairs
+    /// @param parallel Number of threads
+    void update(std::vector<Item<Key, Value>> &&pairs, const Parallel &parallel) {
+        insert_bulk(pairs.size(), parallel.threads,
+                    [&](const size_t i) -> const Key & { return pairs[i].key; },
+                    [&](const size_t i) { return hash_key(pairs[i].key); },
+                    [&](const size_t i) -> Key && { return std::move(pairs[i].key); },
+                    [&](const size_t i) -> Value && { return std::move(pairs[i].value); }, false);
+    }
+
+    /// Create a dictionary from a list of keys, each with the value `value` (or a
+    /// default-constructed value), hashing and deduplicating the keys on several threads.
+    /// The result is the same as for `dictcpp::fromkeys(keys, value)`.
+    ///
+    /// @param keys Keys
+    /// @param value Optional value of every key
+    /// @param parallel Number of threads
+    ///
+    /// @return Dictionary with keys from `keys` and `value` in each entry
+    static Dict fromkeys(const std::vector<Key> &keys, const std::optional<Value> &value, const Parallel &parallel) {
+        const auto fill = value.value_or(Value());
+        Dict dict;
+        dict.insert_bulk(keys.size(), parallel.threads,
+                         [&](const size_t i) -> const Key & { return keys[i]; },
+                         [&](const size_t i) { return dict.hash_key(keys[i]); },
+                         [&](const size_t i) -> const Key & { return keys[i]; },
+                         [&](size_t) -> const Value & { return fill; }, false);
+        return dict;
+    }
+
+    /// Merge a range of dictionaries into a new one, with the same result as updating an empty
+    /// dictionary with each of them in turn, but in one pass: the distinct keys are found first
+    /// (reusing the stored hashes), so that the storage and index are allocated once, at their
+    /// final size. The dictionaries must use equal hash functions. See `dictcpp::merge()`.
+    ///
+    /// @param dicts Forward range of dictionaries. The items of an rvalue container are moved,
+    ///              leaving its dictionaries empty.
+    /// @param combine `nullptr` to keep the last value of each key (as in Python), or a function
+    ///                of the value so far and the next value, returning the combined value
+    /// @param parallel Number of threads
+    ///
+    /// @return Merged dictionary
+    template<std::ranges::forward_range R, typename Combine>
+    static Dict merge(R &&dicts, const Combine &combine, const Parallel &parallel) {
+        using Source = std::remove_reference_t<std::ranges::range_reference_t<R> >;
+        constexpr bool move = !std::is_lvalue_reference_v<R> && !std::ranges::view<std::remove_cvref_t<R> >
+                              && !std::is_const_v<Source>;
+
+        // The dictionary and position of each item
+        std::vector<std::pair<Source *, size_t> > items;
+        size_t count = 0;
+        for (auto &dict: dicts) {
+            count += dict.used;
+        }
+        items.reserve(count);
+        for (auto &dict: dicts) {
+            for (auto i = dict.head; i < dict.key_list.size(); i = dict.next_live(i)) {
+                items.emplace_back(&dict, i);
+            }
+        }
+
+        const auto take = [](auto &list, const size_t i) -> decltype(auto) {
+            if constexpr (move) {
+                return std::move(list[i]);
+            } else {
+                return list[i];
+            }
+        };
+        Dict result = std::ranges::empty(dicts) ? Dict() : Dict(std::ranges::begin(dicts)->get_allocator());
+        if (!std::ranges::empty(dicts)) {
+            result.hasher = std::ranges::begin(dicts)->hasher;
+            result.key_equal = std::ranges::begin(dicts)->key_equal;
+        }
+        result.insert_phased(count, std::max<size_t>(std::min(parallel.threads, count / parallel_grain), 1),
+                             [&](const size_t i) -> const Key & { return items[i].first->key_list[items[i].second]; },
+                             [&](const size_t i) { return items[i].first->hash_list[items[i].second]; },
+                             [&](const size_t i) -> decltype(auto) { return take(items[i].first->key_list, items[i].second); },
+                             [&](const size_t i) -> decltype(auto) { return take(items[i].first->val_list, items[i].second); },
+                             false, combine);
+
+        if constexpr (move) {
+            for (auto &dict: dicts) {
+                dict.clear();
+            }
         }
+        return result;
+    }
+
+    /// Replace the value of each item with `function(key, value)`
+    ///
+    /// @param function Function of a key and its (constant) value, returning the new value
+    template<typename Function>
+    void transform_values(Function function) {
+        transform_values(std::move(function), Parallel{1});
+    }
+
+    /// Replace the value of each item with `function(key, value)`, calling `function` on several
+    /// threads at once for different items. If it throws, some values may have been replaced.
+    ///
+    /// @param function Function of a key and its (constant) value, returning the new value
+    /// @param parallel Number of threads
+    template<typename Function>
+    void transform_values(Function function, const Parallel &parallel) {
+        // Packed values are divided by words, so that no two threads write to the same word
+        constexpr size_t unit = packed_values ? 64 : 1;
+        const auto first_unit = head / unit;
+        const auto units = (key_list.size() + unit - 1) / unit - first_unit;
+        const auto parts = std::max<size_t>(std::min(parallel.threads, used / parallel_grain), 1);
+        const auto &self = *this;
+        detail::parallel_for(units, parts, [&](size_t, const size_t first, const size_t last) {
+            const auto end = std::min((first_unit + last) * unit, key_list.size());
+            for (auto i = std::max((first_unit + first) * unit, head); i < end; ++i) {
+                if (is_live(i)) {
+                    val_list[i] = function(self.key_list[i], self.val_list[i]);
+                }
+            }
+        });
     }
 
 
@@ -357,13 +3452,49 @@ public:
     /// @param other Dictionary
     ///
     /// @return Dictionary which merges `this` and `other`
-    Dict operator|(const Dict &other) const {
+    Dict operator|(const Dict &other) const & {
         auto dict = copy();
         dict.update(other);
 
         return dict;
     }
 
+    /// Create a new dictionary with merged keys from `this` and `other`, moving the
+    /// entries of `other`.
+    ///
+    /// @param other Dictionary (left empty)
+    ///
+    /// @return Dictionary which merges `this` and `other`
+    Dict operator|(Dict &&other) const & {
+        auto dict = copy();
+        dict.update(std::move(other));
+
+        return dict;
+    }
+
+    /// Merge `other` into a temporary dictionary, reusing its storage for the result.
+    ///
+    /// @param other Dictionary
+    ///
+    /// @return Dictionary which merges `this` and `other`
+    Dict operator|(const Dict &other) && {
+        update(other);
+
+        return std::move(*this);
+    }
+
+    /// Merge `other` into a temporary dictionary, moving the entries of `other` and reusing
+    /// the storage of `this` for the result.
+    ///
+    /// @param other Dictionary (left empty)
+    ///
+    /// @return Dictionary which merges `this` and `other`
+    Dict operator|(Dict &&other) && {
+        update(std::move(other));
+
+        return std::move(*this);
+    }
+
     /// Updates dictionary with values from another. Wrapper for `update()`
     ///
     /// @param other Another dictionary
@@ -371,6 +3502,13 @@ public:
         update(other);
     }
 
+    /// Updates dictionary with values moved from another. Wrapper for `update()`
+    ///
+    /// @param other Another dictionary (left empty)
+    void operator|=(Dict &&other) {
+        update(std::move(other));
+    }
+
     /// Updates dictionary with values from initializer list. Wrapper for `update()`
     ///
     /// @param list An list of key-value pairs
@@ -384,35 +3522,309 @@ public:
     void operator|=(const std::vector<Item<Key, Value>> &key_values) {
         update(key_values);
     }
+
+    /// Update dictionary with the pairs of any range (e.g. a `std::map`). Wrapper for `update()`
+    ///
+    /// @param range Range of `Item`s, `std::pair`s or other tuple-like pairs
+    template<typename R> requires is_item_range<R>
+    void operator|=(R &&range) {
+        update(std::forward<R>(range));
+    }
+
+    /// Convert the dictionary to another map type, e.g. `std::map<Key, Value>` or
+    /// `std::unordered_map<Key, Value>`, inserting the items in order. The result is reserved
+    /// first if it supports `reserve()`.
+    ///
+    /// @tparam Map Map type, constructible by default and with `emplace(key, value)`
+    ///
+    /// @return Map holding copies of the items
+    template<typename Map>
+    Map to() const & {
+        Map map;
+        if constexpr (requires { map.reserve(used); }) {
+            map.reserve(used);
+        }
+        for (auto i = head; i < key_list.size(); i = next_live(i)) {
+            map.emplace(key_list[i], val_list[i]);
+        }
+        return map;
+    }
+
+    /// Convert the dictionary to another map type, moving the items, so that the dictionary is
+    /// left empty
+    ///
+    /// @tparam Map Map type, constructible by default and with `emplace(key, value)`
+    ///
+    /// @return Map holding the items
+    template<typename Map>
+    Map to() && {
+        Map map;
+        if constexpr (requires { map.reserve(used); }) {
+            map.reserve(used);
+        }
+        for (auto i = head; i < key_list.size(); i = next_live(i)) {
+            map.emplace(std::move(key_list[i]), std::move(val_list[i]));
+        }
+        clear();
+        return map;
+    }
+
+    /// Convert the dictionary to a map template instantiated with its key and value types, e.g.
+    /// `dict.to<std::map>()` for a `std::map<Key, Value>`
+    ///
+    /// @tparam Map Map template
+    ///
+    /// @return Map holding copies of the items
+    template<template<typename...> typename Map>
+    Map<Key, Value> to() const & {
+        return to<Map<Key, Value> >();
+    }
+
+    /// Convert the dictionary to a map template instantiated with its key and value types,
+    /// moving the items, so that the dictionary is left empty
+    ///
+    /// @tparam Map Map template
+    ///
+    /// @return Map holding the items
+    template<template<typename...> typename Map>
+    Map<Key, Value> to() && {
+        return std::move(*this).template to<Map<Key, Value> >();
+    }
 };
 
-// TODO Template specialisation for Value `bool`
-// TODO Add map constructor, converter and updater
 
 /// Return all keys from a `Dict` as a list (vector)
 ///
 /// @tparam Key Dictionary key type
 /// @tparam Value Dictionary value type
+/// @tparam Hash Dictionary hash function
+/// @tparam KeyEqual Dictionary key comparison
+/// @tparam InlineCapacity Number of items stored inline
+/// @tparam Allocator Dictionary allocator
 /// @param dict Dictionary `Dict`
 ///
 /// @return Vector of keys
-template<typename Key, typename Value>
-std::vector<Key> list(const Dict<Key, Value> &dict) {
-    return dict.keys();
+template<typename Key, typename Value, typename Hash, typename KeyEqual, size_t InlineCapacity, typename Allocator>
+std::vector<Key> list(const Dict<Key, Value, Hash, KeyEqual, InlineCapacity, Allocator> &dict) {
+    return std::vector<Key>(dict.begin(), dict.end());
 }
 
 /// Get the length (size) of a dictionary
 ///
 /// @tparam Key Dictionary key type
 /// @tparam Value Dictionary value type
+/// @tparam Hash Dictionary hash function
+/// @tparam KeyEqual Dictionary key comparison
+/// @tparam InlineCapacity Number of items stored inline
+/// @tparam Allocator Dictionary allocator
 /// @param dict Dictionary
 ///
 /// @return Length (size) of a dictionary (number of keys)
-template<typename Key, typename Value>
-size_t len(const Dict<Key, Value> &dict) {
+template<typename Key, typename Value, typename Hash, typename KeyEqual, size_t InlineCapacity, typename Allocator>
+size_t len(const Dict<Key, Value, Hash, KeyEqual, InlineCapacity, Allocator> &dict) {
     return dict.size();
 }
 
+namespace detail {
+// Keys kept from one side of a set operation: none, all, or those present in (or absent from)
+// the other side
+enum class Keep { none, all, present, absent };
+}
+
+/// A lazy view of the result of a set operation between the keys of a dictionary and other keys,
+/// as given by `&`, `|`, `-` and `^` on a key view. The keys kept from the left side are given
+/// first, in their order, then those kept from the right side. Each key is looked up in the index
+/// of the other side as the view is iterated, so no intermediate set is built.
+///
+/// @tparam Left View of the keys of a dictionary
+/// @tparam Right Key view, or set of keys owned by the view
+template<typename Left, typename Right>
+class KeySetView : public std::ranges::view_interface<KeySetView<Left, Right> > {
+    using Keep = detail::Keep;
+
+    Left left;
+    Right right;
+    Keep keep_left = Keep::none;
+    Keep keep_right = Keep::none;
+
+    static_assert(std::is_same_v<std::ranges::range_reference_t<const Left>, std::ranges::range_reference_t<const Right> >,
+                  "Set operations need keys of the same type on both sides");
+
+    template<typename Other, typename K>
+    static bool keeps(const Keep keep, const Other &other, const K &key) {
+        switch (keep) {
+            case Keep::all:
+                return true;
+            case Keep::present:
+                return other.contains(key);
+            case Keep::absent:
+                return !other.contains(key);
+            default:
+                return false;
+        }
+    }
+
+public:
+    class iterator {
+        const KeySetView *view = nullptr;
+        std::ranges::iterator_t<const Left> left_it{};
+        std::ranges::iterator_t<const Right> right_it{};
+
+        // Skip the keys which are not kept, moving to the right side after the left one
+        void settle() {
+            const auto left_end = std::ranges::end(view->left);
+            while (left_it != left_end && !keeps(view->keep_left, view->right, *left_it)) {
+                ++left_it;
+            }
+            if (left_it == left_end) {
+                const auto right_end = std::ranges::end(view->right);
+                while (right_it != right_end && !keeps(view->keep_right, view->left, *right_it)) {
+                    ++right_it;
+                }
+            }
+        }
+
+    public:
+        using value_type = std::ranges::range_value_t<const Left>;
+        using reference = std::ranges::range_reference_t<const Left>;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::forward_iterator_tag;
+
+        iterator() = default;
+
+        iterator(const KeySetView *view, const std::ranges::iterator_t<const Left> left_it,
+                 const std::ranges::iterator_t<const Right> right_it) : view(view), left_it(left_it),
+                                                                        right_it(right_it) {
+            settle();
+        }
+
+        reference operator*() const {
+            return left_it != std::ranges::end(view->left) ? *left_it : *right_it;
+        }
+
+        iterator &operator++() {
+            if (left_it != std::ranges::end(view->left)) {
+                ++left_it;
+            } else {
+                ++right_it;
+            }
+            settle();
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const iterator &other) const {
+            return left_it == other.left_it && right_it == other.right_it;
+        }
+    };
+
+    KeySetView() = default;
+
+    KeySetView(Left left, Right right, const Keep keep_left, const Keep keep_right) : left(std::move(left)),
+        right(std::move(right)), keep_left(keep_left), keep_right(keep_right) {
+    }
+
+    iterator begin() const {
+        return {
+            this, keep_left == Keep::none ? std::ranges::end(left) : std::ranges::begin(left),
+            keep_right == Keep::none ? std::ranges::end(right) : std::ranges::begin(right)
+        };
+    }
+
+    iterator end() const {
+        return {this, std::ranges::end(left), std::ranges::end(right)};
+    }
+};
+
+namespace detail {
+// The right side of a set operation on keys: key views are kept, dictionaries are viewed (or
+// owned, if they are rvalues), and any other range of keys is collected into a set
+template<typename KeySet, typename R>
+auto probed_keys(R &&other) {
+    using T = std::remove_cvref_t<R>;
+    if constexpr (std::is_lvalue_reference_v<R> && requires { { other.keys() } -> ProbedKeys; }) {
+        return other.keys();
+    } else if constexpr (ProbedKeys<T> && (std::ranges::view<T> || !std::is_lvalue_reference_v<R>)) {
+        return T(std::forward<R>(other));
+    } else {
+        return collect_keys<KeySet>(std::forward<R>(other));
+    }
+}
+
+// A set operation between a key view and other keys, with the keys kept from each side
+template<typename DictType, typename Access, typename R, typename Choose>
+auto key_set_operation(const DictView<DictType, Access> &keys, R &&other, const Choose &choose) {
+    auto right = probed_keys<typename std::remove_const_t<DictType>::KeySet>(std::forward<R>(other));
+    using View = KeySetView<DictView<DictType, Access>, decltype(right)>;
+    const auto [keep_left, keep_right] = choose(keys.size(), static_cast<size_t>(std::ranges::size(right)));
+    return View(keys, std::move(right), keep_left, keep_right);
+}
+}
+
+/// Keys in both a key view and `other` (as `d.keys() & other` in Python). Only the smaller side is
+/// iterated, in its order, and its keys are looked up in the larger one.
+///
+/// @param keys Keys of a dictionary
+/// @param other Key view, dictionary or range of keys (collected into a set first)
+///
+/// @return Lazy view of the keys in both
+template<typename DictType, typename Access, std::ranges::input_range R> requires Access::set_like
+auto operator&(const DictView<DictType, Access> &keys, R &&other) {
+    using detail::Keep;
+    return detail::key_set_operation(keys, std::forward<R>(other), [](const size_t left, const size_t right) {
+        return left <= right ? std::pair{Keep::present, Keep::none} : std::pair{Keep::none, Keep::present};
+    });
+}
+
+/// Keys in a key view or in `other` (as `d.keys() | other` in Python): the keys of the view, then
+/// those of `other` which are not in the view
+///
+/// @param keys Keys of a dictionary
+/// @param other Key view, dictionary or range of keys (collected into a set first)
+///
+/// @return Lazy view of the keys in either
+template<typename DictType, typename Access, std::ranges::input_range R> requires Access::set_like
+auto operator|(const DictView<DictType, Access> &keys, R &&other) {
+    using detail::Keep;
+    return detail::key_set_operation(keys, std::forward<R>(other), [](size_t, size_t) {
+        return std::pair{Keep::all, Keep::absent};
+    });
+}
+
+/// Keys in a key view but not in `other` (as `d.keys() - other` in Python), in the order of the view
+///
+/// @param keys Keys of a dictionary
+/// @param other Key view, dictionary or range of keys (collected into a set first)
+///
+/// @return Lazy view of the keys only in the view
+template<typename DictType, typename Access, std::ranges::input_range R> requires Access::set_like
+auto operator-(const DictView<DictType, Access> &keys, R &&other) {
+    using detail::Keep;
+    return detail::key_set_operation(keys, std::forward<R>(other), [](size_t, size_t) {
+        return std::pair{Keep::absent, Keep::none};
+    });
+}
+
+/// Keys in either a key view or `other` but not in both (as `d.keys() ^ other` in Python): those
+/// of the view, then those of `other`
+///
+/// @param keys Keys of a dictionary
+/// @param other Key view, dictionary or range of keys (collected into a set first)
+///
+/// @return Lazy view of the keys in exactly one side
+template<typename DictType, typename Access, std::ranges::input_range R> requires Access::set_like
+auto operator^(const DictView<DictType, Access> &keys, R &&other) {
+    using detail::Keep;
+    return detail::key_set_operation(keys, std::forward<R>(other), [](size_t, size_t) {
+        return std::pair{Keep::absent, Keep::absent};
+    });
+}
+
 /// Initialise a `Dict` using an initializer list
 ///
 /// @tparam Key Dictionary key type
@@ -440,16 +3852,88 @@ Dict<Key, Value> fromkeys(
     const std::optional<Value> &value = std::nullopt
 ) {
     Dict<Key, Value> dict;
+    dict.reserve(keys.size());
     for (const auto &key: keys) {
         if (value) {
-            dict[key] = *value;
+            dict.try_emplace(key, *value);
         } else {
-            dict[key] = Value();
+            dict.try_emplace(key);
         }
     }
 
     return dict;
 }
+
+/// Create a new dictionary from a list of keys and a single value `value`, hashing and
+/// deduplicating the keys on several threads. The result is the same as for `fromkeys(keys, value)`.
+///
+/// @tparam Key Dictionary key type
+/// @tparam Value Dictionary value type
+/// @param keys Keys
+/// @param value Optional value to fill dictionary
+/// @param parallel Number of threads
+///
+/// @return Dictionary with keys from `keys` and `value` in each entry.
+template<typename Key, typename Value>
+Dict<Key, Value> fromkeys(const std::vector<Key> &keys, const std::optional<Value> &value, const Parallel &parallel) {
+    return Dict<Key, Value>::fromkeys(keys, value, parallel);
+}
+
+/// Merge a range of dictionaries (e.g. a `std::vector` of partial results) into a new one, with
+/// the same result as `result |= dict` for each of them in turn: the keys are in order of first
+/// occurrence, and the last value of each key is kept (as in Python). The storage and index of
+/// the result are allocated once, at their final size. Large merges are divided between the
+/// threads of `parallel`.
+///
+/// @tparam R Forward range of `Dict`s
+/// @param dicts Dictionaries. The items of an rvalue container are moved, leaving its
+///              dictionaries empty.
+/// @param parallel Number of threads (default: 1)
+///
+/// @return Merged dictionary
+template<std::ranges::forward_range R>
+std::remove_cvref_t<std::ranges::range_value_t<R> > merge(R &&dicts, const Parallel &parallel = Parallel{1}) {
+    return std::remove_cvref_t<std::ranges::range_value_t<R> >::merge(std::forward<R>(dicts), nullptr, parallel);
+}
+
+/// Merge a range of dictionaries into a new one, combining the values of each key which occurs
+/// more than once, e.g. with `std::plus<>()` to sum counts. The storage and index of the result
+/// are allocated once, at their final size. Large merges are divided between the threads of
+/// `parallel`.
+///
+/// @tparam R Forward range of `Dict`s
+/// @tparam Combine Function type
+/// @param dicts Dictionaries. The items of an rvalue container are moved, leaving its
+///              dictionaries empty.
+/// @param combine Function of the value so far and the next value, returning the combined value
+/// @param parallel Number of threads (default: 1)
+///
+/// @return Merged dictionary
+template<std::ranges::forward_range R, typename Combine>
+    requires (!std::is_same_v<std::remove_cvref_t<Combine>, Parallel>)
+std::remove_cvref_t<std::ranges::range_value_t<R> > merge(R &&dicts, Combine combine,
+                                                          const Parallel &parallel = Parallel{1}) {
+    return std::remove_cvref_t<std::ranges::range_value_t<R> >::merge(std::forward<R>(dicts), combine, parallel);
+}
+
+namespace pmr {
+/// A `Dict` using a polymorphic allocator, so that its storage is obtained from a
+/// `std::pmr::memory_resource` (e.g. a `std::pmr::monotonic_buffer_resource` arena)
+///
+/// @tparam Key Type of dictionary `keys`
+/// @tparam Value Type of dictionary `values` (default: `Key`)
+/// @tparam Hash Hash function for keys (default: `dictcpp::Hash<Key>`)
+/// @tparam KeyEqual Equality comparison for keys (default: `std::equal_to<>`)
+/// @tparam InlineCapacity Number of items stored inline (default: `default_inline_capacity`)
+template<typename Key, typename Value = Key, typename Hash = dictcpp::Hash<Key>, typename KeyEqual = std::equal_to<>,
+    size_t InlineCapacity = default_inline_capacity<Key, Value> >
+using Dict = dictcpp::Dict<Key, Value, Hash, KeyEqual, InlineCapacity,
+    std::pmr::polymorphic_allocator<Item<Key, Value> > >;
+}
 }
 
+/// Views only refer to the dictionary, so iterators remain valid after the view is destroyed
+template<typename DictType, typename Access>
+inline constexpr bool std::ranges::enable_borrowed_range<dictcpp::DictView<DictType, Access> > = true;
+
 #endif //DICTCPP_HPP
@@ -0,0 +1,538 @@
+#ifndef DICTCPP_FROZEN_DICT_HPP
+#define DICTCPP_FROZEN_DICT_HPP
+#include "dictcpp.hpp"
+
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+namespace dictcpp {
+/// An immutable dictionary, for data which is built once and then only read.
+///
+/// The items are stored in a contiguous array in insertion order, indexed by a minimal perfect
+/// hash function built over the keys at construction: every key is mapped to a distinct slot of
+/// a table with exactly one slot per key, so any lookup inspects a single entry, without probing.
+/// As a `FrozenDict` cannot be modified, any number of threads can read it at once without
+/// synchronisation.
+///
+/// Keys with equal hashes cannot be separated by the perfect hash: all but one of them are kept
+/// in a small overflow list, sorted by hash, which is only searched when a lookup reaches a key
+/// with the same hash but a different value.
+///
+/// @tparam Key Type of dictionary `keys`
+/// @tparam Value Type of dictionary `values` (default: `Key`)
+/// @tparam Hash Hash function for keys (default: `dictcpp::Hash<Key>`)
+/// @tparam KeyEqual Equality comparison for keys (default: `std::equal_to<>`)
+template<typename Key, typename Value = Key, typename Hash = dictcpp::Hash<Key>, typename KeyEqual = std::equal_to<> >
+class FrozenDict {
+    std::vector<Key> key_list;
+    // Values of `FrozenDict<Key, bool>` are packed into bits, as for `Dict`
+    using ValueList = std::conditional_t<std::is_same_v<Value, bool>, BitList<std::vector<uint64_t> >, std::vector<Value> >;
+
+    ValueList val_list;
+
+    // The perfect hash uses "hash and displace": keys are grouped into buckets by their hash,
+    // and for each bucket a seed is chosen such that the keys of the bucket, hashed again with
+    // the seed, land in free slots. `seeds` holds the seed of each bucket (or, for a bucket of a
+    // single key, `direct_slot` and the slot of the key), and `slots` holds the position of the
+    // entry in each slot. A lookup is then one hash, one seed, one slot and one key comparison.
+    // Each slot also keeps 32 bits of the hash of its key, so that looking up a missing key
+    // rarely compares the keys themselves.
+    struct Slot {
+        uint32_t index;
+        uint32_t check;
+    };
+
+    std::vector<uint32_t> seeds;
+    std::vector<Slot> slots;
+    // Keys whose hash equals that of a key in `slots`, as (mixed hash, position), sorted by hash
+    std::vector<std::pair<uint64_t, uint32_t> > overflow;
+    size_t used = 0;
+    [[no_unique_address]] Hash hasher;
+    [[no_unique_address]] KeyEqual key_equal;
+
+    // Types which can be used to look up keys (as for `Dict`)
+    template<typename K>
+    static constexpr bool is_lookup_key = std::is_same_v<K, Key> || (
+                                              requires {
+                                                  typename Hash::is_transparent;
+                                                  typename KeyEqual::is_transparent;
+                                              }
+                                              && std::is_invocable_r_v<size_t, const Hash &, const K &>
+                                              && std::is_invocable_r_v<bool, const KeyEqual &, const Key &, const K &>);
+
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+    static constexpr uint32_t direct_slot = uint32_t{1} << 31;
+    static constexpr size_t max_size = direct_slot;
+    // Average number of keys per bucket: more keys use fewer seeds, but take longer to place
+    static constexpr size_t bucket_load = 2;
+
+    // Spread the bits of the hash, so that both the bucket and the slot depend on all of them
+    static uint64_t mix(const size_t hash) {
+        const auto mixed = static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15;
+        return mixed ^ (mixed >> 32);
+    }
+
+    // Map `x` to [0, n) using its high 32 bits (multiplying, rather than dividing)
+    static size_t reduce(const uint64_t x, const size_t n) {
+        return static_cast<size_t>(((x >> 32) * n) >> 32);
+    }
+
+    static size_t bucket_of(const uint64_t mixed, const size_t bucket_count) {
+        return reduce(mixed, bucket_count);
+    }
+
+    static uint32_t check_of(const uint64_t mixed) {
+        return static_cast<uint32_t>(mixed);
+    }
+
+    static size_t slot_of(const uint64_t mixed, const uint32_t seed, const size_t n) {
+        return reduce((mixed ^ (seed * 0xD6E8FEB86659FD93)) * 0x9E3779B97F4A7C15, n);
+    }
+
+    template<typename K>
+    size_t lookup(const K &key) const {
+        if (used == 0) {
+            return npos;
+        }
+
+        const auto mixed = mix(hasher(key));
+        const auto seed = seeds[bucket_of(mixed, seeds.size())];
+        const auto slot = seed & direct_slot ? seed & ~direct_slot : slot_of(mixed, seed, used);
+        const auto [index, check] = slots[slot];
+        if (check != check_of(mixed)) {
+            return npos;
+        }
+        if (key_equal(key_list[index], key)) {
+            return index;
+        }
+        return overflow.empty() ? npos : lookup_overflow(key, mixed);
+    }
+
+    // Look up a key among those whose hash equals that of another key
+    template<typename K>
+    size_t lookup_overflow(const K &key, const uint64_t mixed) const {
+        auto it = std::ranges::lower_bound(overflow, mixed, {}, &std::pair<uint64_t, uint32_t>::first);
+        for (; it != overflow.end() && it->first == mixed; ++it) {
+            if (key_equal(key_list[it->second], key)) {
+                return it->second;
+            }
+        }
+        return npos;
+    }
+
+    // Build the perfect hash over the keys, largest buckets first (as those are the hardest to
+    // place), finishing with the buckets of a single key, which are placed in the remaining
+    // slots directly
+    void build() {
+        used = key_list.size();
+        if (used == 0) {
+            return;
+        }
+        if (used > max_size) {
+            throw std::length_error("Too many keys for a FrozenDict");
+        }
+
+        std::vector<uint64_t> mixed(used);
+        for (size_t i = 0; i < used; ++i) {
+            mixed[i] = mix(hasher(key_list[i]));
+        }
+
+        // Sort the entries by bucket, so that the entries of each bucket are contiguous
+        const auto bucket_count = (used + bucket_load - 1) / bucket_load;
+        std::vector<uint32_t> bucket_start(bucket_count + 1);
+        for (size_t i = 0; i < used; ++i) {
+            bucket_start[bucket_of(mixed[i], bucket_count) + 1]++;
+        }
+        for (size_t b = 0; b < bucket_count; ++b) {
+            bucket_start[b + 1] += bucket_start[b];
+        }
+        std::vector<uint32_t> entries(used);
+        {
+            auto next = bucket_start;
+            for (size_t i = 0; i < used; ++i) {
+                entries[next[bucket_of(mixed[i], bucket_count)]++] = static_cast<uint32_t>(i);
+            }
+        }
+
+        std::vector<uint32_t> order(bucket_count);
+        for (size_t b = 0; b < bucket_count; ++b) {
+            order[b] = static_cast<uint32_t>(b);
+        }
+        std::ranges::stable_sort(order, std::greater<>(), [&](const uint32_t b) {
+            return bucket_start[b + 1] - bucket_start[b];
+        });
+
+        seeds.assign(bucket_count, 0);
+        slots.assign(used, {});
+        std::vector<bool> taken(used);
+        std::vector<size_t> candidate;
+        size_t free_slot = 0;
+        for (const auto b: order) {
+            const auto first = entries.begin() + bucket_start[b];
+            auto last = entries.begin() + bucket_start[b + 1];
+            if (first == last) {
+                break;
+            }
+
+            // No seed separates keys with equal hashes (which are always in the same bucket):
+            // only the first one is placed, and the others are set aside
+            auto kept = first + 1;
+            for (auto i = first + 1; i != last; ++i) {
+                if (std::any_of(first, kept, [&](const uint32_t j) { return mixed[j] == mixed[*i]; })) {
+                    overflow.emplace_back(mixed[*i], *i);
+                } else {
+                    *kept++ = *i;
+                }
+            }
+            last = kept;
+            const auto n = static_cast<size_t>(last - first);
+
+            if (n == 1) {
+                while (taken[free_slot]) {
+                    free_slot++;
+                }
+                taken[free_slot] = true;
+                slots[free_slot] = {*first, check_of(mixed[*first])};
+                seeds[b] = direct_slot | static_cast<uint32_t>(free_slot);
+                continue;
+            }
+
+            for (uint32_t seed = 0;; ++seed) {
+                if (seed == direct_slot) {
+                    throw std::runtime_error("No perfect hash found for the keys");
+                }
+                candidate.clear();
+                for (auto i = first; i != last; ++i) {
+                    const auto slot = slot_of(mixed[*i], seed, used);
+                    if (taken[slot] || std::ranges::find(candidate, slot) != candidate.end()) {
+                        break;
+                    }
+                    candidate.push_back(slot);
+                }
+                if (candidate.size() == n) {
+                    for (size_t k = 0; k < n; ++k) {
+                        taken[candidate[k]] = true;
+                        const auto index = first[static_cast<std::ptrdiff_t>(k)];
+                        slots[candidate[k]] = {index, check_of(mixed[index])};
+                    }
+                    seeds[b] = seed;
+                    break;
+                }
+            }
+        }
+        std::ranges::sort(overflow);
+    }
+
+    size_t next_live(const size_t index) const {
+        return index + 1;
+    }
+
+    size_t previous_live(const size_t index) const {
+        return index - 1;
+    }
+
+    bool is_compact() const {
+        return true;
+    }
+
+    static constexpr size_t head = 0;
+
+    template<typename DictType, typename Access>
+    friend class DictIterator;
+
+    template<typename DictType, typename Access>
+    friend class DictView;
+
+    struct KeyAccess {
+        // Key views support the operations of sets
+        static constexpr bool set_like = true;
+
+        static const Key &get(const FrozenDict *dict, const size_t index) {
+            return dict->key_list[index];
+        }
+    };
+
+    struct ValueAccess {
+        static decltype(auto) get(const FrozenDict *dict, const size_t index) {
+            return dict->val_list[index];
+        }
+    };
+
+    struct ItemAccess {
+        static auto get(const FrozenDict *dict, const size_t index) {
+            return Item<const Key &, decltype((dict->val_list[index]))>{dict->key_list[index], dict->val_list[index]};
+        }
+    };
+
+public:
+    /// Constant reference to a value: `const Value &`, or a `bool` for `FrozenDict<Key, bool>`
+    using const_value_reference = decltype(std::declval<const ValueList &>()[0]);
+
+    /// Iterator through the keys of a dictionary
+    using const_iterator = DictIterator<const FrozenDict, KeyAccess>;
+    using iterator = const_iterator;
+
+    /// View of the dictionary keys, which supports the operations of sets with other keys
+    using KeysView = DictView<const FrozenDict, KeyAccess>;
+
+    /// Set of keys, into which a range of keys is collected for the set operations of a `KeysView`
+    using KeySet = Dict<Key, bool, Hash, KeyEqual>;
+
+    /// View of the dictionary values
+    using ValuesView = DictView<const FrozenDict, ValueAccess>;
+
+    /// View of the dictionary items, given as `Item`s of references to each key and value
+    using ItemsView = DictView<const FrozenDict, ItemAccess>;
+
+    /// Iterator through the dictionary items, as returned by `find()`
+    using const_item_iterator = typename ItemsView::iterator;
+
+    /// Initialise an empty dictionary
+    FrozenDict() = default;
+
+    /// Initialise a dictionary with the items of `dict`, in the same order
+    ///
+    /// @param dict Dictionary
+    template<size_t InlineCapacity, typename Allocator>
+    explicit FrozenDict(const Dict<Key, Value, Hash, KeyEqual, InlineCapacity, Allocator> &dict) {
+        key_list.reserve(dict.size());
+        val_list.reserve(dict.size());
+        for (const auto &[key, value]: dict.items()) {
+            key_list.push_back(key);
+            val_list.push_back(value);
+        }
+        build();
+    }
+
+    /// Initialise a dictionary using a list of `Item`s. As for `Dict`, a repeated key keeps its
+    /// first position and its last value.
+    ///
+    /// @param key_values A list of dictionary `Item`s (key-value pair)
+    FrozenDict(const std::initializer_list<Item<Key, Value>> &key_values)
+        : FrozenDict(Dict<Key, Value, Hash, KeyEqual>(key_values)) {
+    }
+
+    /// Initialise a dictionary using a std::vector of `Item`s
+    ///
+    /// @param key_values Key-value pairs in a vector
+    explicit FrozenDict(const std::vector<Item<Key, Value>> &key_values)
+        : FrozenDict(Dict<Key, Value, Hash, KeyEqual>(key_values)) {
+    }
+
+    /// Access value at key `key`
+    ///
+    /// @param key Dictionary key
+    ///
+    /// @throws std::out_of_range If key not in dictionary
+    ///
+    /// @return Constant reference to value at `dict[key]`
+    const_value_reference operator[](const Key &key) const {
+        return at<Key>(key);
+    }
+
+    /// Access value at `key` (wrapper to `operator[]`)
+    ///
+    /// @param key Dictionary key
+    ///
+    /// @throws std::out_of_range If key not in dictionary
+    ///
+    /// @return Constant reference to value at `dict[key]`
+    const_value_reference at(const Key &key) const {
+        return at<Key>(key);
+    }
+
+    /// Access value at key `key` (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @throws std::out_of_range If key not in dictionary
+    ///
+    /// @return Constant reference to value at `dict[key]`
+    template<typename K> requires is_lookup_key<K>
+    const_value_reference operator[](const K &key) const {
+        return at<K>(key);
+    }
+
+    /// Access value at `key` with heterogeneous lookup (wrapper to `operator[]`)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @throws std::out_of_range If key not in dictionary
+    ///
+    /// @return Constant reference to value at `dict[key]`
+    template<typename K> requires is_lookup_key<K>
+    const_value_reference at(const K &key) const {
+        const auto index = lookup(key);
+        if (index == npos) {
+            throw std::out_of_range("Key not found in dictionary");
+        }
+
+        return val_list[index];
+    }
+
+    /// Check if dictionary contains `key`
+    ///
+    /// @param key A possible key
+    ///
+    /// @return Whether key is present in dictionary
+    bool contains(const Key &key) const {
+        return lookup(key) != npos;
+    }
+
+    /// Check if dictionary contains `key` (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @return Whether key is present in dictionary
+    template<typename K> requires is_lookup_key<K>
+    bool contains(const K &key) const {
+        return lookup(key) != npos;
+    }
+
+    /// Get value from dictionary at key `key`
+    ///
+    /// @param key Dictionary key
+    /// @param default_value Optional default (default: `std::nullopt`)
+    ///
+    /// @throws std::runtime_error If key not in dictionary and no default value is specified
+    ///
+    /// @return Value at key, if present, default value otherwise
+    Value get(const Key &key, const std::optional<Value> &default_value = std::nullopt) const {
+        return get<Key>(key, default_value);
+    }
+
+    /// Get value from dictionary at key `key` (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    /// @param default_value Optional default (default: `std::nullopt`)
+    ///
+    /// @throws std::runtime_error If key not in dictionary and no default value is specified
+    ///
+    /// @return Value at key, if present, default value otherwise
+    template<typename K> requires is_lookup_key<K>
+    Value get(const K &key, const std::optional<Value> &default_value = std::nullopt) const {
+        const auto index = lookup(key);
+        if (index != npos) {
+            return val_list[index];
+        }
+
+        if (!default_value) {
+            throw std::runtime_error("Key not found in dictionary and no default exists");
+        }
+
+        return default_value.value();
+    }
+
+    /// Find the item with key `key`
+    ///
+    /// @param key Dictionary key
+    ///
+    /// @return Iterator to the item, or `items().end()` if the key is not in the dictionary
+    const_item_iterator find(const Key &key) const {
+        return find<Key>(key);
+    }
+
+    /// Find the item with key `key` (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @return Iterator to the item, or `items().end()` if the key is not in the dictionary
+    template<typename K> requires is_lookup_key<K>
+    const_item_iterator find(const K &key) const {
+        const auto index = lookup(key);
+        return {this, index == npos ? used : index};
+    }
+
+    /// Get the size of the dictionary
+    ///
+    /// @return Number of keys
+    [[nodiscard]] size_t size() const {
+        return used;
+    }
+
+    /// Check if the dictionary is empty
+    ///
+    /// @return Whether the dictionary is empty
+    [[nodiscard]] bool empty() const {
+        return used == 0;
+    }
+
+    /// Get the keys of the dictionary, in insertion order
+    ///
+    /// @return View of the keys
+    KeysView keys() const {
+        return KeysView(this);
+    }
+
+    /// Get the values of the dictionary, in insertion order
+    ///
+    /// @return View of the values
+    ValuesView values() const {
+        return ValuesView(this);
+    }
+
+    /// Get the items of the dictionary, in insertion order
+    ///
+    /// @return View of the items
+    ItemsView items() const {
+        return ItemsView(this);
+    }
+
+    /// Copy the items into a (modifiable) `Dict`
+    ///
+    /// @return Dictionary with the same items, in the same order
+    Dict<Key, Value, Hash, KeyEqual> to_dict() const {
+        Dict<Key, Value, Hash, KeyEqual> dict;
+        dict.reserve(used);
+        for (size_t i = 0; i < used; ++i) {
+            dict.try_emplace(key_list[i], val_list[i]);
+        }
+        return dict;
+    }
+
+    /// Iterator to the first key
+    const_iterator begin() const {
+        return keys().begin();
+    }
+
+    /// Iterator past the last key
+    const_iterator end() const {
+        return keys().end();
+    }
+};
+
+/// Get the keys of a frozen dictionary as a vector
+///
+/// @tparam Key Dictionary key type
+/// @tparam Value Dictionary value type
+/// @tparam Hash Dictionary hash function
+/// @tparam KeyEqual Dictionary key comparison
+/// @param dict Dictionary
+///
+/// @return Vector of keys
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+std::vector<Key> list(const FrozenDict<Key, Value, Hash, KeyEqual> &dict) {
+    return std::vector<Key>(dict.begin(), dict.end());
+}
+
+/// Get the length (size) of a frozen dictionary
+///
+/// @tparam Key Dictionary key type
+/// @tparam Value Dictionary value type
+/// @tparam Hash Dictionary hash function
+/// @tparam KeyEqual Dictionary key comparison
+/// @param dict Dictionary
+///
+/// @return Length (size) of a dictionary (number of keys)
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t len(const FrozenDict<Key, Value, Hash, KeyEqual> &dict) {
+    return dict.size();
+}
+}
+
+#endif //DICTCPP_FROZEN_DICT_HPP
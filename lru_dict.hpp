@@ -0,0 +1,391 @@
+#ifndef DICTCPP_LRU_DICT_HPP
+#define DICTCPP_LRU_DICT_HPP
+#include "dictcpp.hpp"
+
+#include <utility>
+#include <optional>
+#include <stdexcept>
+#include <functional>
+
+namespace dictcpp {
+/// A dictionary holding at most `capacity()` items, which evicts the least recently used item
+/// when it is full (a cache). Its items are kept in the order of their last use, using
+/// `Dict::move_to_end()`, so each access is a single lookup in one table, with no separate list.
+///
+/// Accessing an item (`find()`, `get()`, `at()`, `operator[]`, `insert_or_assign()`) makes it
+/// the most recently used; `contains()` and the views do not.
+///
+/// @tparam Key Type of dictionary `keys`
+/// @tparam Value Type of dictionary `values` (default: `Key`)
+/// @tparam Hash Hash function for keys (default: `dictcpp::Hash<Key>`)
+/// @tparam KeyEqual Equality comparison for keys (default: `std::equal_to<>`)
+template<typename Key, typename Value = Key, typename Hash = dictcpp::Hash<Key>, typename KeyEqual = std::equal_to<> >
+class LruDict {
+public:
+    /// Dictionary holding the items, from the least to the most recently used
+    using DictType = Dict<Key, Value, Hash, KeyEqual>;
+
+    /// Function called with the key and value of each evicted item
+    using EvictionCallback = std::function<void(Key, Value)>;
+
+    using value_reference = typename DictType::value_reference;
+    using item_iterator = typename DictType::item_iterator;
+
+private:
+    DictType dict;
+    size_t max_items;
+    EvictionCallback on_evict;
+
+    static constexpr size_t npos = DictType::npos;
+
+    // Types which can be used to look up keys (as for `Dict`)
+    template<typename K>
+    static constexpr bool is_lookup_key = DictType::template is_lookup_key<K>;
+
+    void evict() {
+        while (dict.size() > max_items) {
+            auto [key, value] = dict.popitem(false);
+            if (on_evict) {
+                on_evict(std::move(key), std::move(value));
+            }
+        }
+    }
+
+    // Position of `key` after making it the most recently used, or `npos`
+    template<typename K>
+    size_t touch(const K &key) {
+        const auto location = dict.locate(key, dict.hash_key(key));
+        if (location.index == npos) {
+            return npos;
+        }
+        return dict.move_entry(location, true);
+    }
+
+    // Insert a new item (known to be absent) constructed from `args` at the end, evicting the
+    // least recently used item if the dictionary is full. Returns the position of the new item.
+    template<typename K, typename... Args>
+    size_t insert(const typename DictType::Location location, const size_t hash, K &&key, Args &&... args) {
+        dict.insert_at(location.slot, hash, std::forward<K>(key), std::forward<Args>(args)...);
+        evict();
+        // Evicting only removes items before the new one, which stays last
+        return dict.key_list.size() - 1;
+    }
+
+    template<typename K, typename M>
+    std::pair<item_iterator, bool> assign(K &&key, M &&value) {
+        const auto hash = dict.hash_key(key);
+        const auto location = dict.locate(key, hash);
+        if (location.index != npos) {
+            const auto index = dict.move_entry(location, true);
+            dict.val_list[index] = std::forward<M>(value);
+            return {item_iterator(&dict, index), false};
+        }
+
+        return {item_iterator(&dict, insert(location, hash, std::forward<K>(key), std::forward<M>(value))), true};
+    }
+
+public:
+    /// Initialise an empty dictionary
+    ///
+    /// @param capacity Maximum number of items
+    /// @param on_evict Function called with the key and value of each evicted item (optional)
+    ///
+    /// @throws std::invalid_argument If `capacity` is zero
+    explicit LruDict(const size_t capacity, EvictionCallback on_evict = {}) : max_items(capacity),
+                                                                             on_evict(std::move(on_evict)) {
+        if (capacity == 0) {
+            throw std::invalid_argument("LruDict capacity must be positive");
+        }
+        dict.reserve(capacity);
+    }
+
+    /// Get the maximum number of items
+    ///
+    /// @return Capacity of the dictionary
+    [[nodiscard]] size_t capacity() const {
+        return max_items;
+    }
+
+    /// Change the maximum number of items, evicting the least recently used items if there are
+    /// more than `capacity`
+    ///
+    /// @param capacity Maximum number of items
+    ///
+    /// @throws std::invalid_argument If `capacity` is zero
+    void set_capacity(const size_t capacity) {
+        if (capacity == 0) {
+            throw std::invalid_argument("LruDict capacity must be positive");
+        }
+        max_items = capacity;
+        evict();
+    }
+
+    /// Get the number of items
+    ///
+    /// @return Number of items
+    [[nodiscard]] size_t size() const {
+        return dict.size();
+    }
+
+    /// Check if the dictionary is empty
+    ///
+    /// @return Whether the dictionary is empty
+    [[nodiscard]] bool empty() const {
+        return dict.empty();
+    }
+
+    /// Check if the dictionary contains `key`, without making it the most recently used
+    ///
+    /// @param key A possible key
+    ///
+    /// @return Whether key is present in dictionary
+    bool contains(const Key &key) const {
+        return dict.contains(key);
+    }
+
+    /// Check if the dictionary contains `key`, without making it the most recently used
+    /// (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @return Whether key is present in dictionary
+    template<typename K> requires is_lookup_key<K>
+    bool contains(const K &key) const {
+        return dict.contains(key);
+    }
+
+    /// Find the item with key `key`, making it the most recently used. Moving the item
+    /// invalidates iterators, including `items().end()`.
+    ///
+    /// @param key Dictionary key
+    ///
+    /// @return Iterator to the item, or `items().end()` if the key is not in the dictionary
+    item_iterator find(const Key &key) {
+        return find<Key>(key);
+    }
+
+    /// Find the item with key `key`, making it the most recently used (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @return Iterator to the item, or `items().end()` if the key is not in the dictionary
+    template<typename K> requires is_lookup_key<K>
+    item_iterator find(const K &key) {
+        const auto index = touch(key);
+        return {&dict, index == npos ? dict.key_list.size() : index};
+    }
+
+    /// Access the value at `key`, making it the most recently used
+    ///
+    /// @param key Dictionary key
+    ///
+    /// @throws std::out_of_range If key not in dictionary
+    ///
+    /// @return Reference to the value
+    value_reference at(const Key &key) {
+        return at<Key>(key);
+    }
+
+    /// Access the value at `key`, making it the most recently used (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @throws std::out_of_range If key not in dictionary
+    ///
+    /// @return Reference to the value
+    template<typename K> requires is_lookup_key<K>
+    value_reference at(const K &key) {
+        const auto index = touch(key);
+        if (index == npos) {
+            throw std::out_of_range("Key not found in dictionary");
+        }
+
+        return dict.val_list[index];
+    }
+
+    /// Get the value at `key`, making it the most recently used, or the default value if the
+    /// key is not in the dictionary
+    ///
+    /// @param key Dictionary key
+    /// @param default_value Optional default (default: `std::nullopt`)
+    ///
+    /// @throws std::runtime_error If key not in dictionary and no default value is specified
+    ///
+    /// @return Value at key, if present, default value otherwise
+    Value get(const Key &key, const std::optional<Value> &default_value = std::nullopt) {
+        return get<Key>(key, default_value);
+    }
+
+    /// Get the value at `key`, making it the most recently used, or the default value if the
+    /// key is not in the dictionary (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    /// @param default_value Optional default (default: `std::nullopt`)
+    ///
+    /// @throws std::runtime_error If key not in dictionary and no default value is specified
+    ///
+    /// @return Value at key, if present, default value otherwise
+    template<typename K> requires is_lookup_key<K>
+    Value get(const K &key, const std::optional<Value> &default_value = std::nullopt) {
+        if (const auto index = touch(key); index != npos) {
+            return dict.val_list[index];
+        }
+
+        if (!default_value) {
+            throw std::runtime_error("Key not found in dictionary and no default exists");
+        }
+
+        return default_value.value();
+    }
+
+    /// Access the value at `key`, making it the most recently used, or insert a
+    /// default-constructed value (evicting the least recently used item if full)
+    ///
+    /// @param key Dictionary key
+    ///
+    /// @return Reference to the value
+    value_reference operator[](const Key &key) {
+        const auto hash = dict.hash_key(key);
+        const auto location = dict.locate(key, hash);
+        if (location.index != npos) {
+            return dict.val_list[dict.move_entry(location, true)];
+        }
+
+        return dict.val_list[insert(location, hash, key)];
+    }
+
+    /// Assign `value` to `key`, making it the most recently used, and inserting it if it is not
+    /// in the dictionary (evicting the least recently used item if full)
+    ///
+    /// @param key Dictionary key
+    /// @param value New value
+    ///
+    /// @return Iterator to the item with key `key`, and whether it was inserted
+    template<typename M>
+    std::pair<item_iterator, bool> insert_or_assign(const Key &key, M &&value) {
+        return assign(key, std::forward<M>(value));
+    }
+
+    /// Assign `value` to `key`, making it the most recently used, and inserting it (by moving
+    /// the key) if it is not in the dictionary (evicting the least recently used item if full)
+    ///
+    /// @param key Dictionary key
+    /// @param value New value
+    ///
+    /// @return Iterator to the item with key `key`, and whether it was inserted
+    template<typename M>
+    std::pair<item_iterator, bool> insert_or_assign(Key &&key, M &&value) {
+        return assign(std::move(key), std::forward<M>(value));
+    }
+
+    /// Remove `key` and return its value, else return the default value
+    ///
+    /// @param key Dictionary key
+    /// @param default_value Optional default value (default: `std::nullopt`)
+    ///
+    /// @throws std::runtime_error If key not in dictionary and no default value
+    ///
+    /// @return Value at key in dictionary if it exists, otherwise the default
+    Value pop(const Key &key, std::optional<Value> default_value = std::nullopt) {
+        return dict.pop(key, std::move(default_value));
+    }
+
+    /// Remove `key` and return its value, else return the default value (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    /// @param default_value Optional default value (default: `std::nullopt`)
+    ///
+    /// @throws std::runtime_error If key not in dictionary and no default value
+    ///
+    /// @return Value at key in dictionary if it exists, otherwise the default
+    template<typename K> requires is_lookup_key<K>
+    Value pop(const K &key, std::optional<Value> default_value = std::nullopt) {
+        return dict.pop(key, std::move(default_value));
+    }
+
+    /// Remove `key` from the dictionary (the eviction callback is not called)
+    ///
+    /// @param key Dictionary key
+    ///
+    /// @throws std::out_of_range If key not in dictionary
+    void del(const Key &key) {
+        dict.del(key);
+    }
+
+    /// Remove `key` from the dictionary (the eviction callback is not called, heterogeneous
+    /// lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @throws std::out_of_range If key not in dictionary
+    template<typename K> requires is_lookup_key<K>
+    void del(const K &key) {
+        dict.del(key);
+    }
+
+    /// Remove all items (the eviction callback is not called)
+    void clear() {
+        dict.clear();
+        dict.reserve(max_items);
+    }
+
+    /// Get a view of the keys, from the least to the most recently used
+    ///
+    /// @return Live view of the keys
+    typename DictType::KeysView keys() const {
+        return dict.keys();
+    }
+
+    /// Get a view of the values, from the least to the most recently used
+    ///
+    /// @return Live view of the values
+    typename DictType::template ValuesView<true> values() const {
+        return dict.values();
+    }
+
+    /// Get a view of the items, from the least to the most recently used, through which values
+    /// can be modified (without making the items the most recently used)
+    ///
+    /// @return Live view of the items
+    typename DictType::template ItemsView<false> items() {
+        return dict.items();
+    }
+
+    /// Get a view of the items, from the least to the most recently used
+    ///
+    /// @return Live view of the items
+    typename DictType::template ItemsView<true> items() const {
+        return dict.items();
+    }
+
+    /// Returns an iterator through the keys, from the least recently used
+    ///
+    /// @return Iterator pointing to the least recently used key
+    typename DictType::const_iterator begin() const {
+        return dict.begin();
+    }
+
+    /// Return an iterator pointing past the most recently used key
+    ///
+    /// @return Iterator pointing to the end of the keys
+    typename DictType::const_iterator end() const {
+        return dict.end();
+    }
+};
+
+/// Get the length (size) of an LRU dictionary
+///
+/// @tparam Key Dictionary key type
+/// @tparam Value Dictionary value type
+/// @tparam Hash Dictionary hash function
+/// @tparam KeyEqual Dictionary key comparison
+/// @param dict Dictionary
+///
+/// @return Length (size) of a dictionary (number of keys)
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t len(const LruDict<Key, Value, Hash, KeyEqual> &dict) {
+    return dict.size();
+}
+}
+
+#endif //DICTCPP_LRU_DICT_HPP
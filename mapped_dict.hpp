@@ -0,0 +1,725 @@
+#ifndef DICTCPP_MAPPED_DICT_HPP
+#define DICTCPP_MAPPED_DICT_HPP
+#include "dictcpp.hpp"
+
+#include <span>
+#include <array>
+#include <limits>
+#include <ranges>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <optional>
+#include <stdexcept>
+#include <filesystem>
+#include <string_view>
+#include <type_traits>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace dictcpp {
+/// Conversion of keys and values to and from the streaming binary format of `write_binary()`
+/// and `read_binary()`. Trivially copyable types are written as their bytes and strings as their
+/// length and characters. Specialise `Serializer` to support other types.
+///
+/// @tparam T Type of keys or values
+template<typename T>
+struct Serializer {
+    static_assert(std::is_trivially_copyable_v<T>, "Specialise dictcpp::Serializer for this type");
+
+    static void write(std::ostream &out, const T &value) {
+        out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    static T read(std::istream &in) {
+        T value;
+        in.read(reinterpret_cast<char *>(&value), sizeof(T));
+        return value;
+    }
+};
+
+/// Binary conversion of strings: the length, then the characters
+///
+/// @tparam CharT Character type
+/// @tparam Traits Character traits
+/// @tparam Alloc String allocator
+template<typename CharT, typename Traits, typename Alloc>
+struct Serializer<std::basic_string<CharT, Traits, Alloc> > {
+    static void write(std::ostream &out, const std::basic_string<CharT, Traits, Alloc> &value) {
+        Serializer<uint64_t>::write(out, value.size());
+        out.write(reinterpret_cast<const char *>(value.data()), static_cast<std::streamsize>(value.size() * sizeof(CharT)));
+    }
+
+    static std::basic_string<CharT, Traits, Alloc> read(std::istream &in) {
+        const auto size = Serializer<uint64_t>::read(in);
+        if (!in) {
+            return {};
+        }
+        std::basic_string<CharT, Traits, Alloc> value;
+        // The string grows as it is read, so that a corrupt length fails at the end of the stream
+        constexpr uint64_t chunk = 1 << 16;
+        for (uint64_t done = 0; done < size && in; done += chunk) {
+            const auto n = static_cast<size_t>(std::min(chunk, size - done));
+            value.resize(value.size() + n);
+            in.read(reinterpret_cast<char *>(value.data() + value.size() - n), static_cast<std::streamsize>(n * sizeof(CharT)));
+        }
+        return value;
+    }
+};
+
+namespace detail {
+inline constexpr std::array<char, 8> stream_magic = {'D', 'I', 'C', 'T', 'C', 'P', 'P', 'S'};
+inline constexpr std::array<char, 8> mapped_magic = {'D', 'I', 'C', 'T', 'C', 'P', 'P', 'M'};
+inline constexpr uint32_t byte_order = 0x01020304;
+
+template<typename T>
+struct is_std_string : std::false_type {
+};
+
+template<typename Traits, typename Alloc>
+struct is_std_string<std::basic_string<char, Traits, Alloc> > : std::true_type {
+};
+
+// Keys stored in a mapped file: strings, or trivially copyable types whose values are equal
+// exactly when their bytes are (as keys are hashed by their bytes)
+template<typename T>
+concept MappableKey = is_std_string<T>::value || (std::is_trivially_copyable_v<T>
+                                                  && std::has_unique_object_representations_v<T>
+                                                  && !std::is_pointer_v<T>);
+
+template<typename T>
+concept MappableValue = is_std_string<T>::value || (std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>);
+
+// How keys and values are stored in a mapped file: as fixed-size records, or strings (an
+// offset table followed by the characters)
+enum class Layout : uint32_t { fixed = 0, string = 1 };
+
+template<typename T>
+constexpr Layout layout_of = is_std_string<T>::value ? Layout::string : Layout::fixed;
+
+template<typename T>
+constexpr uint32_t size_of = is_std_string<T>::value ? 1 : sizeof(T);
+
+// Hash which is the same in every process (unlike `std::hash`): FNV-1a over the bytes of the
+// key, or the value of an integer key
+inline uint64_t stable_hash(const std::string_view bytes) {
+    uint64_t hash = 0xCBF29CE484222325;
+    for (const auto c: bytes) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001B3;
+    }
+    return hash;
+}
+
+template<typename T>
+uint64_t stable_hash(const T &key) {
+    if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+        return static_cast<uint64_t>(key);
+    } else {
+        return stable_hash(std::string_view(reinterpret_cast<const char *>(&key), sizeof(T)));
+    }
+}
+
+inline uint64_t mix(uint64_t hash) {
+    hash *= 0x9E3779B97F4A7C15;
+    return hash ^ (hash >> 32);
+}
+
+// Header at the start of a mapped file. Offsets are from the start of the file, and each
+// section starts on a multiple of `alignment` bytes.
+struct MappedHeader {
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t byte_order;
+    Layout key_layout;
+    uint32_t key_size;
+    Layout value_layout;
+    uint32_t value_size;
+    uint64_t count;
+    uint64_t table_size;
+    uint64_t index_offset;
+    uint64_t key_offset;
+    uint64_t value_offset;
+    uint64_t file_size;
+};
+
+inline constexpr uint32_t mapped_version = 1;
+inline constexpr uint64_t alignment = 64;
+
+inline uint64_t align(const uint64_t offset) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+}
+
+/// Write a dictionary in a streaming binary format, to be read by `read_binary()`. Keys and
+/// values of any type with a `Serializer` can be written.
+///
+/// @tparam Key Dictionary key type
+/// @tparam Value Dictionary value type
+/// @tparam Hash Dictionary hash function
+/// @tparam KeyEqual Dictionary key comparison
+/// @tparam InlineCapacity Number of items stored inline
+/// @tparam Allocator Dictionary allocator
+/// @param out Output stream (opened in binary mode)
+/// @param dict Dictionary
+///
+/// @throws std::runtime_error If writing fails
+template<typename Key, typename Value, typename Hash, typename KeyEqual, size_t InlineCapacity, typename Allocator>
+void write_binary(std::ostream &out, const Dict<Key, Value, Hash, KeyEqual, InlineCapacity, Allocator> &dict) {
+    out.write(detail::stream_magic.data(), detail::stream_magic.size());
+    Serializer<uint32_t>::write(out, detail::byte_order);
+    Serializer<uint64_t>::write(out, dict.size());
+    for (const auto &[key, value]: dict.items()) {
+        Serializer<Key>::write(out, key);
+        Serializer<Value>::write(out, value);
+    }
+    if (!out) {
+        throw std::runtime_error("Failed to write dictionary");
+    }
+}
+
+/// Read a dictionary written by `write_binary()`. The storage is allocated once, before the
+/// items are read.
+///
+/// @tparam DictType Dictionary type, e.g. `Dict<std::string, int>`
+/// @param in Input stream (opened in binary mode)
+///
+/// @throws std::runtime_error If the stream is not a dictionary, or ends early
+///
+/// @return Dictionary
+template<typename DictType>
+DictType read_binary(std::istream &in) {
+    using Key = std::remove_cvref_t<decltype(*std::declval<DictType>().begin())>;
+    using Value = std::remove_cvref_t<decltype(std::declval<const DictType &>().values().front())>;
+
+    std::array<char, 8> magic{};
+    in.read(magic.data(), magic.size());
+    const auto order = Serializer<uint32_t>::read(in);
+    const auto count = Serializer<uint64_t>::read(in);
+    if (!in || magic != detail::stream_magic || order != detail::byte_order) {
+        throw std::runtime_error("Not a dictionary, or written on a different platform");
+    }
+
+    DictType dict;
+    // A corrupt count fails when the stream ends, rather than reserving too much
+    dict.reserve(static_cast<size_t>(std::min<uint64_t>(count, 1 << 20)));
+    for (uint64_t i = 0; i < count; ++i) {
+        auto key = Serializer<Key>::read(in);
+        auto value = Serializer<Value>::read(in);
+        if (!in) {
+            throw std::runtime_error("Dictionary ends early");
+        }
+        dict.insert_or_assign(std::move(key), std::move(value));
+    }
+    return dict;
+}
+
+/// Write a dictionary in a format which can be mapped into memory and used in place by
+/// `MappedDict`, without reading it: the items in insertion order, and a hash index over them.
+///
+/// Keys may be strings, or trivially copyable types compared by their bytes (e.g. integers, or
+/// structures of integers without padding). Values may be strings or trivially copyable types.
+/// Files can only be used on platforms with the same byte order and type sizes.
+///
+/// @tparam Key Dictionary key type
+/// @tparam Value Dictionary value type
+/// @tparam Hash Dictionary hash function
+/// @tparam KeyEqual Dictionary key comparison
+/// @tparam InlineCapacity Number of items stored inline
+/// @tparam Allocator Dictionary allocator
+/// @param out Output stream (opened in binary mode)
+/// @param dict Dictionary
+///
+/// @throws std::runtime_error If writing fails
+template<typename Key, typename Value, typename Hash, typename KeyEqual, size_t InlineCapacity, typename Allocator>
+    requires detail::MappableKey<Key> && detail::MappableValue<Value>
+void write_mapped(std::ostream &out, const Dict<Key, Value, Hash, KeyEqual, InlineCapacity, Allocator> &dict) {
+    const uint64_t count = dict.size();
+    if (count >= std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("Too many items to map");
+    }
+
+    // Index: at most half full, linear probing. A slot holds the position of its item plus one
+    // (zero if empty), and the high 32 bits of the mixed hash of its key.
+    uint64_t table_size = 16;
+    while (table_size < 2 * count) {
+        table_size *= 2;
+    }
+    std::vector<uint64_t> index(table_size);
+    uint64_t position = 0;
+    for (const auto &key: dict.keys()) {
+        uint64_t mixed;
+        if constexpr (detail::is_std_string<Key>::value) {
+            mixed = detail::mix(detail::stable_hash(std::string_view(key)));
+        } else {
+            mixed = detail::mix(detail::stable_hash(key));
+        }
+        auto slot = mixed & (table_size - 1);
+        while (index[slot] != 0) {
+            slot = (slot + 1) & (table_size - 1);
+        }
+        index[slot] = (mixed >> 32 << 32) | ++position;
+    }
+
+    // Size of the section for keys or values (strings: offsets of each string, then characters)
+    const auto section_size = [&]<typename T>(const auto &elements, std::type_identity<T>) {
+        if constexpr (detail::is_std_string<T>::value) {
+            uint64_t characters = 0;
+            for (const auto &element: elements) {
+                characters += element.size();
+            }
+            return (count + 1) * sizeof(uint64_t) + characters;
+        } else {
+            return count * sizeof(T);
+        }
+    };
+
+    detail::MappedHeader header{};
+    header.magic = detail::mapped_magic;
+    header.version = detail::mapped_version;
+    header.byte_order = detail::byte_order;
+    header.key_layout = detail::layout_of<Key>;
+    header.key_size = detail::size_of<Key>;
+    header.value_layout = detail::layout_of<Value>;
+    header.value_size = detail::size_of<Value>;
+    header.count = count;
+    header.table_size = table_size;
+    header.index_offset = detail::align(sizeof(header));
+    header.key_offset = detail::align(header.index_offset + table_size * sizeof(uint64_t));
+    header.value_offset = detail::align(header.key_offset + section_size(dict.keys(), std::type_identity<Key>()));
+    header.file_size = header.value_offset + section_size(dict.values(), std::type_identity<Value>());
+
+    uint64_t written = 0;
+    const auto write = [&](const void *data, const uint64_t size) {
+        out.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+        written += size;
+    };
+    const auto pad_to = [&](const uint64_t offset) {
+        constexpr std::array<char, detail::alignment> zeros{};
+        write(zeros.data(), offset - written);
+    };
+    const auto write_section = [&]<typename T>(const auto &elements, std::type_identity<T>) {
+        if constexpr (detail::is_std_string<T>::value) {
+            uint64_t offset = 0;
+            write(&offset, sizeof(offset));
+            for (const auto &element: elements) {
+                offset += element.size();
+                write(&offset, sizeof(offset));
+            }
+            for (const auto &element: elements) {
+                write(element.data(), element.size());
+            }
+        } else {
+            for (const auto &element: elements) {
+                write(&element, sizeof(T));
+            }
+        }
+    };
+
+    write(&header, sizeof(header));
+    pad_to(header.index_offset);
+    write(index.data(), table_size * sizeof(uint64_t));
+    pad_to(header.key_offset);
+    write_section(dict.keys(), std::type_identity<Key>());
+    pad_to(header.value_offset);
+    write_section(dict.values(), std::type_identity<Value>());
+    if (!out) {
+        throw std::runtime_error("Failed to write dictionary");
+    }
+}
+
+/// A read-only mapping of a file into memory (`mmap` on POSIX systems, `MapViewOfFile` on
+/// Windows). The pages are loaded on first access and shared by all processes mapping the file.
+class MappedFile {
+    const std::byte *data = nullptr;
+    size_t size = 0;
+#if defined(_WIN32)
+    HANDLE mapping = nullptr;
+#endif
+
+    void release() noexcept {
+#if defined(_WIN32)
+        if (data) {
+            UnmapViewOfFile(data);
+        }
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        mapping = nullptr;
+#else
+        if (data) {
+            munmap(const_cast<std::byte *>(data), size);
+        }
+#endif
+        data = nullptr;
+        size = 0;
+    }
+
+public:
+    /// Create an empty mapping
+    MappedFile() = default;
+
+    /// Map the file at `path` into memory
+    ///
+    /// @param path File path
+    ///
+    /// @throws std::runtime_error If the file cannot be opened or mapped
+    explicit MappedFile(const std::filesystem::path &path) {
+#if defined(_WIN32)
+        const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                        FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Cannot open " + path.string());
+        }
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size)) {
+            CloseHandle(file);
+            throw std::runtime_error("Cannot read the size of " + path.string());
+        }
+        size = static_cast<size_t>(file_size.QuadPart);
+        if (size != 0) {
+            mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            data = mapping ? static_cast<const std::byte *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+        }
+        CloseHandle(file);
+        if (size != 0 && !data) {
+            release();
+            throw std::runtime_error("Cannot map " + path.string());
+        }
+#else
+        const int file = open(path.c_str(), O_RDONLY);
+        if (file < 0) {
+            throw std::runtime_error("Cannot open " + path.string());
+        }
+        struct stat status{};
+        if (fstat(file, &status) != 0) {
+            close(file);
+            throw std::runtime_error("Cannot read the size of " + path.string());
+        }
+        size = static_cast<size_t>(status.st_size);
+        if (size != 0) {
+            void *address = mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+            data = address == MAP_FAILED ? nullptr : static_cast<const std::byte *>(address);
+        }
+        close(file);
+        if (size != 0 && !data) {
+            size = 0;
+            throw std::runtime_error("Cannot map " + path.string());
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    MappedFile(MappedFile &&other) noexcept : data(std::exchange(other.data, nullptr)),
+                                              size(std::exchange(other.size, 0))
+#if defined(_WIN32)
+                                              , mapping(std::exchange(other.mapping, nullptr))
+#endif
+    {
+    }
+
+    MappedFile &operator=(MappedFile &&other) noexcept {
+        if (this != &other) {
+            release();
+            data = std::exchange(other.data, nullptr);
+            size = std::exchange(other.size, 0);
+#if defined(_WIN32)
+            mapping = std::exchange(other.mapping, nullptr);
+#endif
+        }
+        return *this;
+    }
+
+    ~MappedFile() {
+        release();
+    }
+
+    /// Get the contents of the file
+    ///
+    /// @return Bytes of the file
+    [[nodiscard]] std::span<const std::byte> bytes() const {
+        return {data, size};
+    }
+};
+
+/// A read-only dictionary used in place in memory, as written by `write_mapped()`: typically a
+/// mapped file, so that opening it takes constant time whatever its size, only the pages used
+/// by lookups are read, and the pages are shared by every process using the file.
+///
+/// String keys and values are accessed as `std::string_view`s into the data, other values are
+/// returned by copy.
+///
+/// The header and the sizes of the sections are validated when the dictionary is opened. The
+/// index and the string offsets are only checked as they are used (so that opening takes constant
+/// time), and corrupt entries throw the same `std::runtime_error`.
+///
+/// @tparam Key Type of dictionary `keys`
+/// @tparam Value Type of dictionary `values`
+template<detail::MappableKey Key, detail::MappableValue Value>
+class MappedDict {
+    MappedFile file;
+    std::span<const std::byte> data;
+    detail::MappedHeader header{};
+    const std::byte *index = nullptr;
+
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+public:
+    /// Type of keys when accessed (`std::string_view` for string keys)
+    using key_type = std::conditional_t<detail::is_std_string<Key>::value, std::string_view, Key>;
+
+    /// Type of values when accessed (`std::string_view` for string values)
+    using mapped_type = std::conditional_t<detail::is_std_string<Value>::value, std::string_view, Value>;
+
+private:
+    template<typename T>
+    T load(const uint64_t offset) const {
+        T value;
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        return value;
+    }
+
+    template<typename T, typename Result>
+    Result element(const uint64_t section, const size_t position) const {
+        if constexpr (detail::is_std_string<T>::value) {
+            const auto first = load<uint64_t>(section + position * sizeof(uint64_t));
+            const auto last = load<uint64_t>(section + (position + 1) * sizeof(uint64_t));
+            // The last offset, the length of all strings, was checked by `check_section`
+            if (first > last || last > load<uint64_t>(section + header.count * sizeof(uint64_t))) {
+                throw std::runtime_error("Corrupt dictionary file");
+            }
+            const auto characters = section + (header.count + 1) * sizeof(uint64_t);
+            return {reinterpret_cast<const char *>(data.data() + characters + first), static_cast<size_t>(last - first)};
+        } else {
+            return load<T>(section + position * sizeof(T));
+        }
+    }
+
+    // Check that a section of keys or values lies within the data
+    template<typename T>
+    void check_section(const uint64_t offset, const uint64_t next) const {
+        if constexpr (detail::is_std_string<T>::value) {
+            const auto characters = offset + (header.count + 1) * sizeof(uint64_t);
+            if (characters > next || load<uint64_t>(characters - sizeof(uint64_t)) > next - characters) {
+                throw std::runtime_error("Corrupt dictionary file");
+            }
+        } else if (offset + header.count * sizeof(T) > next) {
+            throw std::runtime_error("Corrupt dictionary file");
+        }
+    }
+
+    size_t lookup(const key_type &key) const {
+        const auto mixed = detail::mix(detail::stable_hash(key));
+        const auto check = mixed >> 32;
+        const auto mask = header.table_size - 1;
+        auto slot = mixed & mask;
+        // The index of a valid file always has empty slots, which end every probe
+        for (uint64_t probes = 0; probes < header.table_size; ++probes, slot = (slot + 1) & mask) {
+            uint64_t entry;
+            std::memcpy(&entry, index + slot * sizeof(uint64_t), sizeof(entry));
+            if (entry == 0) {
+                return npos;
+            }
+            if (entry >> 32 == check) {
+                const auto position = (entry & 0xFFFFFFFF) - 1;
+                if (position >= header.count) {
+                    throw std::runtime_error("Corrupt dictionary file");
+                }
+                if (this->key(static_cast<size_t>(position)) == key) {
+                    return static_cast<size_t>(position);
+                }
+            }
+        }
+        throw std::runtime_error("Corrupt dictionary file");
+    }
+
+    void open(const std::span<const std::byte> bytes) {
+        data = bytes;
+        if (data.size() < sizeof(header)) {
+            throw std::runtime_error("Not a dictionary file");
+        }
+        std::memcpy(&header, data.data(), sizeof(header));
+        if (header.magic != detail::mapped_magic) {
+            throw std::runtime_error("Not a dictionary file");
+        }
+        if (header.version != detail::mapped_version) {
+            throw std::runtime_error("Unsupported dictionary file version " + std::to_string(header.version));
+        }
+        if (header.byte_order != detail::byte_order) {
+            throw std::runtime_error("Dictionary file written on a platform with a different byte order");
+        }
+        if (header.key_layout != detail::layout_of<Key> || header.key_size != detail::size_of<Key>
+            || header.value_layout != detail::layout_of<Value> || header.value_size != detail::size_of<Value>) {
+            throw std::runtime_error("Dictionary file has different key or value types");
+        }
+        if (header.file_size > data.size() || header.table_size > data.size() || !std::has_single_bit(header.table_size)
+            || header.table_size < 2 * header.count || header.index_offset < sizeof(header)
+            || header.index_offset + header.table_size * sizeof(uint64_t) > header.key_offset
+            || header.key_offset > header.value_offset || header.value_offset > header.file_size) {
+            throw std::runtime_error("Corrupt dictionary file");
+        }
+        check_section<Key>(header.key_offset, header.value_offset);
+        check_section<Value>(header.value_offset, header.file_size);
+        index = data.data() + header.index_offset;
+    }
+
+public:
+    /// Use a dictionary in memory (which must outlive the `MappedDict`)
+    ///
+    /// @param bytes Dictionary, as written by `write_mapped()`
+    ///
+    /// @throws std::runtime_error If the data is not a dictionary with these key and value types
+    explicit MappedDict(const std::span<const std::byte> bytes) {
+        open(bytes);
+    }
+
+    /// Map a dictionary file into memory
+    ///
+    /// @param path Dictionary file, as written by `write_mapped()`
+    ///
+    /// @throws std::runtime_error If the file cannot be mapped, or is not a dictionary with these key and value types
+    explicit MappedDict(const std::filesystem::path &path): file(path) {
+        open(file.bytes());
+    }
+
+    /// Get the size of the dictionary
+    ///
+    /// @return Number of keys
+    [[nodiscard]] size_t size() const {
+        return static_cast<size_t>(header.count);
+    }
+
+    /// Check if the dictionary is empty
+    ///
+    /// @return Whether the dictionary is empty
+    [[nodiscard]] bool empty() const {
+        return header.count == 0;
+    }
+
+    /// Check if dictionary contains `key`
+    ///
+    /// @param key A possible key
+    ///
+    /// @return Whether key is present in dictionary
+    bool contains(const key_type &key) const {
+        return lookup(key) != npos;
+    }
+
+    /// Access value at `key`
+    ///
+    /// @param key Dictionary key
+    ///
+    /// @throws std::out_of_range If key not in dictionary
+    ///
+    /// @return Value at key
+    mapped_type at(const key_type &key) const {
+        const auto position = lookup(key);
+        if (position == npos) {
+            throw std::out_of_range("Key not found in dictionary");
+        }
+
+        return value(position);
+    }
+
+    /// Access value at `key` (wrapper to `at()`)
+    ///
+    /// @param key Dictionary key
+    ///
+    /// @throws std::out_of_range If key not in dictionary
+    ///
+    /// @return Value at key
+    mapped_type operator[](const key_type &key) const {
+        return at(key);
+    }
+
+    /// Get value from dictionary at key `key`
+    ///
+    /// @param key Dictionary key
+    /// @param default_value Optional default (default: `std::nullopt`)
+    ///
+    /// @throws std::runtime_error If key not in dictionary and no default value is specified
+    ///
+    /// @return Value at key, if present, default value otherwise
+    mapped_type get(const key_type &key, const std::optional<mapped_type> &default_value = std::nullopt) const {
+        const auto position = lookup(key);
+        if (position != npos) {
+            return value(position);
+        }
+
+        if (!default_value) {
+            throw std::runtime_error("Key not found in dictionary and no default exists");
+        }
+
+        return default_value.value();
+    }
+
+    /// Get the key at `position` in insertion order
+    ///
+    /// @param position Position, less than `size()`
+    ///
+    /// @return Key
+    key_type key(const size_t position) const {
+        return element<Key, key_type>(header.key_offset, position);
+    }
+
+    /// Get the value at `position` in insertion order
+    ///
+    /// @param position Position, less than `size()`
+    ///
+    /// @return Value
+    mapped_type value(const size_t position) const {
+        return element<Value, mapped_type>(header.value_offset, position);
+    }
+
+    /// Get the keys of the dictionary, in insertion order
+    ///
+    /// @return View of the keys
+    auto keys() const {
+        return std::views::iota(size_t{0}, size()) | std::views::transform([this](const size_t i) {
+            return key(i);
+        });
+    }
+
+    /// Get the values of the dictionary, in insertion order
+    ///
+    /// @return View of the values
+    auto values() const {
+        return std::views::iota(size_t{0}, size()) | std::views::transform([this](const size_t i) {
+            return value(i);
+        });
+    }
+
+    /// Copy the items into a `Dict`
+    ///
+    /// @return Dictionary with the same items, in the same order
+    Dict<Key, Value> to_dict() const {
+        Dict<Key, Value> dict;
+        dict.reserve(size());
+        for (size_t i = 0; i < size(); ++i) {
+            dict.try_emplace(Key(key(i)), Value(value(i)));
+        }
+        return dict;
+    }
+};
+}
+
+#endif //DICTCPP_MAPPED_DICT_HPP
@@ -0,0 +1,666 @@
+#ifndef DICTCPP_SPLIT_DICT_HPP
+#define DICTCPP_SPLIT_DICT_HPP
+#include "dictcpp.hpp"
+
+#include <memory>
+#include <ranges>
+#include <vector>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+
+namespace dictcpp {
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+class SplitDict;
+
+/// An immutable table of keys, in order, with their hash index, which can be shared by many
+/// `SplitDict`s (as the keys of Python's "split-table" dictionaries are). Created by
+/// `shared_keys()`.
+///
+/// @tparam Key Type of dictionary `keys`
+/// @tparam Hash Hash function for keys (default: `dictcpp::Hash<Key>`)
+/// @tparam KeyEqual Equality comparison for keys (default: `std::equal_to<>`)
+template<typename Key, typename Hash = dictcpp::Hash<Key>, typename KeyEqual = std::equal_to<> >
+class SharedKeys {
+    // The position of each key, kept compact, so that the key at a position is found directly
+    Dict<Key, size_t, Hash, KeyEqual> positions;
+
+    template<typename K, typename V, typename H, typename E>
+    friend class SplitDict;
+
+    // Types which can be used to look up keys (as for `Dict`)
+    template<typename K>
+    static constexpr bool is_lookup_key = std::is_same_v<K, Key> || (
+                                              requires {
+                                                  typename Hash::is_transparent;
+                                                  typename KeyEqual::is_transparent;
+                                              }
+                                              && std::is_invocable_r_v<size_t, const Hash &, const K &>
+                                              && std::is_invocable_r_v<bool, const KeyEqual &, const Key &, const K &>);
+
+    // A `SplitDict` may only modify a table which no other dictionary uses
+    void append(const Key &key) {
+        positions.try_emplace(key, positions.size());
+    }
+
+    void truncate(const size_t n) {
+        while (positions.size() > n) {
+            positions.popitem();
+        }
+    }
+
+    void erase(const size_t position) {
+        const Key key = this->key(position);
+        positions.del(key);
+        for (auto &&[k, p]: positions.items()) {
+            if (p > position) {
+                p--;
+            }
+        }
+        positions.compact();
+    }
+
+public:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    /// Initialise a table of keys. A repeated key keeps its first position.
+    ///
+    /// @param keys Keys, in order
+    template<std::ranges::input_range Keys = std::initializer_list<Key> >
+    explicit SharedKeys(const Keys &keys = {}) {
+        for (const auto &key: keys) {
+            positions.try_emplace(key, positions.size());
+        }
+    }
+
+    /// Get the number of keys
+    ///
+    /// @return Number of keys
+    [[nodiscard]] size_t size() const {
+        return positions.size();
+    }
+
+    /// Get the key at `position`
+    ///
+    /// @param position Position of the key, less than `size()`
+    ///
+    /// @return Key
+    const Key &key(const size_t position) const {
+        return positions.keys()[position];
+    }
+
+    /// Get the position of `key`
+    ///
+    /// @param key A possible key
+    ///
+    /// @return Position of the key, `npos` if it is not in the table
+    size_t position(const Key &key) const {
+        return position<Key>(key);
+    }
+
+    /// Get the position of `key` (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @return Position of the key, `npos` if it is not in the table
+    template<typename K> requires is_lookup_key<K>
+    size_t position(const K &key) const {
+        const auto item = positions.find(key);
+        return item == positions.items().end() ? npos : (*item).value;
+    }
+
+    /// Get the keys, in order
+    ///
+    /// @return View of the keys
+    auto keys() const {
+        return positions.keys();
+    }
+};
+
+/// Create a table of keys to share between `SplitDict`s
+///
+/// @tparam Key Dictionary key type
+/// @tparam Hash Dictionary hash function (default: `dictcpp::Hash<Key>`)
+/// @tparam KeyEqual Dictionary key comparison (default: `std::equal_to<>`)
+/// @param keys Keys, in order
+///
+/// @return Shared table of keys
+template<typename Key, typename Hash = dictcpp::Hash<Key>, typename KeyEqual = std::equal_to<> >
+std::shared_ptr<SharedKeys<Key, Hash, KeyEqual> > shared_keys(const std::initializer_list<Key> &keys) {
+    return std::make_shared<SharedKeys<Key, Hash, KeyEqual> >(keys);
+}
+
+/// Create a table of keys to share between `SplitDict`s
+///
+/// @tparam Key Dictionary key type
+/// @tparam Hash Dictionary hash function (default: `dictcpp::Hash<Key>`)
+/// @tparam KeyEqual Dictionary key comparison (default: `std::equal_to<>`)
+/// @param keys Keys, in order
+///
+/// @return Shared table of keys
+template<typename Key, typename Hash = dictcpp::Hash<Key>, typename KeyEqual = std::equal_to<> >
+std::shared_ptr<SharedKeys<Key, Hash, KeyEqual> > shared_keys(const std::vector<Key> &keys) {
+    return std::make_shared<SharedKeys<Key, Hash, KeyEqual> >(keys);
+}
+
+/// A dictionary whose keys (and their hash index) are kept in a `SharedKeys` table, which can be
+/// shared by many dictionaries, so that each dictionary only stores its values (as Python's
+/// "split-table" dictionaries do). This suits many records with the same keys, e.g. parsed rows
+/// or objects.
+///
+/// The dictionary holds the values of the first `size()` keys of the table. It keeps sharing the
+/// table while keys are inserted in the order of the table, and while the last key is removed.
+/// Any other change (inserting a key out of order or not in the table, or removing another key)
+/// first gives the dictionary a private copy of the table, unless no other dictionary uses it,
+/// after which it behaves as an ordinary dictionary. Removing a key other than the last is then
+/// linear in the size of the dictionary.
+///
+/// Copies of a dictionary share its table.
+///
+/// @tparam Key Type of dictionary `keys`
+/// @tparam Value Type of dictionary `values` (default: `Key`)
+/// @tparam Hash Hash function for keys (default: `dictcpp::Hash<Key>`)
+/// @tparam KeyEqual Equality comparison for keys (default: `std::equal_to<>`)
+template<typename Key, typename Value = Key, typename Hash = dictcpp::Hash<Key>, typename KeyEqual = std::equal_to<> >
+class SplitDict {
+public:
+    /// Table of keys used by the dictionary
+    using KeyTable = SharedKeys<Key, Hash, KeyEqual>;
+
+private:
+    // Values of `SplitDict<Key, bool>` are packed into bits, as for `Dict`
+    using ValueList = std::conditional_t<std::is_same_v<Value, bool>, BitList<std::vector<uint64_t> >, std::vector<Value> >;
+
+    std::shared_ptr<KeyTable> table;
+    ValueList val_list;
+
+    static constexpr size_t npos = KeyTable::npos;
+
+    // Give the dictionary its own table, holding only its keys (if it is the only user of its
+    // table, the keys it does not use are removed instead)
+    void make_private() {
+        if (table.use_count() == 1) {
+            table->truncate(val_list.size());
+            return;
+        }
+        auto keys = std::make_shared<KeyTable>();
+        for (size_t i = 0; i < val_list.size(); ++i) {
+            keys->append(table->key(i));
+        }
+        table = std::move(keys);
+    }
+
+    // Position of `key`, inserting it with a value constructed from `args` if it is not present
+    template<typename... Args>
+    std::pair<size_t, bool> try_emplace_position(const Key &key, Args &&... args) {
+        const auto position = table->position(key);
+        if (position < val_list.size()) {
+            return {position, false};
+        }
+        if (position != val_list.size()) {
+            make_private();
+            table->append(key);
+        }
+        val_list.emplace_back(std::forward<Args>(args)...);
+        return {val_list.size() - 1, true};
+    }
+
+    void erase_position(const size_t position) {
+        if (position + 1 != val_list.size()) {
+            make_private();
+            table->erase(position);
+        }
+        val_list.erase(val_list.begin() + static_cast<std::ptrdiff_t>(position));
+    }
+
+    // Types which can be used to look up keys (as for `Dict`)
+    template<typename K>
+    static constexpr bool is_lookup_key = KeyTable::template is_lookup_key<K>;
+
+    template<typename K>
+    size_t lookup(const K &key) const {
+        const auto position = table->position(key);
+        return position < val_list.size() ? position : npos;
+    }
+
+    size_t next_live(const size_t index) const {
+        return index + 1;
+    }
+
+    size_t previous_live(const size_t index) const {
+        return index - 1;
+    }
+
+    bool is_compact() const {
+        return true;
+    }
+
+    template<typename DictType, typename Access>
+    friend class DictIterator;
+
+    struct KeyAccess {
+        static const Key &get(const SplitDict *dict, const size_t index) {
+            return dict->table->key(index);
+        }
+    };
+
+    struct ValueAccess {
+        template<typename DictType>
+        static decltype(auto) get(DictType *dict, const size_t index) {
+            return dict->val_list[index];
+        }
+    };
+
+    struct ItemAccess {
+        template<typename DictType>
+        static auto get(DictType *dict, const size_t index) {
+            return Item<const Key &, decltype((dict->val_list[index]))>{dict->table->key(index), dict->val_list[index]};
+        }
+    };
+
+    // Items are kept in their iterator while referenced, so the elements accessed directly are
+    // returned by value
+    template<typename DictType, typename Access>
+    struct View : std::ranges::subrange<DictIterator<DictType, Access>, DictIterator<DictType, Access>,
+                std::ranges::subrange_kind::sized> {
+        using std::ranges::subrange<DictIterator<DictType, Access>, DictIterator<DictType, Access>,
+            std::ranges::subrange_kind::sized>::subrange;
+
+        using element = decltype(Access::get(std::declval<DictType *>(), 0));
+
+        element front() const {
+            return element(*this->begin());
+        }
+
+        element back() const {
+            return element(*std::ranges::prev(this->end()));
+        }
+
+        element operator[](const std::ptrdiff_t n) const {
+            return element(this->begin()[n]);
+        }
+    };
+
+    template<typename Access, typename DictType>
+    static View<DictType, Access> view(DictType *dict) {
+        using Iterator = DictIterator<DictType, Access>;
+        return {Iterator(dict, 0), Iterator(dict, dict->val_list.size()), dict->val_list.size()};
+    }
+
+    static ValueList to_value_list(std::vector<Value> &&values) {
+        if constexpr (std::is_same_v<ValueList, std::vector<Value> >) {
+            return std::move(values);
+        } else {
+            ValueList list;
+            list.reserve(values.size());
+            for (const bool value: values) {
+                list.push_back(value);
+            }
+            return list;
+        }
+    }
+
+public:
+    /// Reference to a value: `Value &`, or a `BitReference` for `SplitDict<Key, bool>`
+    using value_reference = decltype(std::declval<ValueList &>()[0]);
+
+    /// Constant reference to a value: `const Value &`, or a `bool` for `SplitDict<Key, bool>`
+    using const_value_reference = decltype(std::declval<const ValueList &>()[0]);
+
+    /// Iterator through the keys of a dictionary
+    using const_iterator = DictIterator<const SplitDict, KeyAccess>;
+    using iterator = const_iterator;
+
+    /// View of the dictionary keys
+    using KeysView = View<const SplitDict, KeyAccess>;
+
+    /// View of the dictionary values
+    ///
+    /// @tparam Const Whether the values are accessed as `const`
+    template<bool Const>
+    using ValuesView = View<std::conditional_t<Const, const SplitDict, SplitDict>, ValueAccess>;
+
+    /// View of the dictionary items, given as `Item`s of references to each key and value
+    ///
+    /// @tparam Const Whether the values are accessed as `const`
+    template<bool Const>
+    using ItemsView = View<std::conditional_t<Const, const SplitDict, SplitDict>, ItemAccess>;
+
+    /// Initialise an empty dictionary with its own table of keys
+    SplitDict(): table(std::make_shared<KeyTable>()) {
+    }
+
+    /// Initialise an empty dictionary using a table of keys
+    ///
+    /// @param keys Table of keys, shared with other dictionaries
+    explicit SplitDict(std::shared_ptr<KeyTable> keys): table(std::move(keys)) {
+    }
+
+    /// Initialise a dictionary using a table of keys and the values of its first keys
+    ///
+    /// @param keys Table of keys, shared with other dictionaries
+    /// @param values Values of the first `values.size()` keys of the table
+    ///
+    /// @throws std::length_error If there are more values than keys
+    SplitDict(std::shared_ptr<KeyTable> keys, std::vector<Value> values): table(std::move(keys)),
+                                                                          val_list(to_value_list(std::move(values))) {
+        if (val_list.size() > table->size()) {
+            throw std::length_error("More values than keys");
+        }
+    }
+
+    /// Initialise a dictionary (with its own table of keys) using a list of `Item`s
+    ///
+    /// @param key_values A list of dictionary `Item`s (key-value pair)
+    SplitDict(const std::initializer_list<Item<Key, Value>> &key_values): SplitDict() {
+        for (const auto &[key, value]: key_values) {
+            insert_or_assign(key, value);
+        }
+    }
+
+    /// Get the table of keys of the dictionary (which may be shared with other dictionaries)
+    ///
+    /// @return Table of keys
+    const std::shared_ptr<KeyTable> &key_table() const {
+        return table;
+    }
+
+    /// Access the value at key `key` or assign a default value to key `key`
+    ///
+    /// @param key Dictionary key
+    ///
+    /// @return Reference to value at `dict[key]`
+    value_reference operator[](const Key &key) {
+        return val_list[try_emplace_position(key).first];
+    }
+
+    /// Access value at `key`
+    ///
+    /// @param key Dictionary key
+    ///
+    /// @throws std::out_of_range If key not in dictionary
+    ///
+    /// @return Constant reference to value at `dict[key]`
+    const_value_reference at(const Key &key) const {
+        return at<Key>(key);
+    }
+
+    /// Access value at `key` (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @throws std::out_of_range If key not in dictionary
+    ///
+    /// @return Constant reference to value at `dict[key]`
+    template<typename K> requires is_lookup_key<K>
+    const_value_reference at(const K &key) const {
+        const auto position = lookup(key);
+        if (position == npos) {
+            throw std::out_of_range("Key not found in dictionary");
+        }
+
+        return val_list[position];
+    }
+
+    /// Access value at `key`
+    ///
+    /// @param key Dictionary key
+    ///
+    /// @throws std::out_of_range If key not in dictionary
+    ///
+    /// @return Reference to value at `dict[key]`
+    value_reference at(const Key &key) {
+        return at<Key>(key);
+    }
+
+    /// Access value at `key` (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @throws std::out_of_range If key not in dictionary
+    ///
+    /// @return Reference to value at `dict[key]`
+    template<typename K> requires is_lookup_key<K>
+    value_reference at(const K &key) {
+        const auto position = lookup(key);
+        if (position == npos) {
+            throw std::out_of_range("Key not found in dictionary");
+        }
+
+        return val_list[position];
+    }
+
+    /// Check if dictionary contains `key`
+    ///
+    /// @param key A possible key
+    ///
+    /// @return Whether key is present in dictionary
+    bool contains(const Key &key) const {
+        return contains<Key>(key);
+    }
+
+    /// Check if dictionary contains `key` (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @return Whether key is present in dictionary
+    template<typename K> requires is_lookup_key<K>
+    bool contains(const K &key) const {
+        return lookup(key) != npos;
+    }
+
+    /// Get value from dictionary at key `key`
+    ///
+    /// @param key Dictionary key
+    /// @param default_value Optional default (default: `std::nullopt`)
+    ///
+    /// @throws std::runtime_error If key not in dictionary and no default value is specified
+    ///
+    /// @return Value at key, if present, default value otherwise
+    Value get(const Key &key, const std::optional<Value> &default_value = std::nullopt) const {
+        return get<Key>(key, default_value);
+    }
+
+    /// Get value from dictionary at key `key` (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    /// @param default_value Optional default (default: `std::nullopt`)
+    ///
+    /// @throws std::runtime_error If key not in dictionary and no default value is specified
+    ///
+    /// @return Value at key, if present, default value otherwise
+    template<typename K> requires is_lookup_key<K>
+    Value get(const K &key, const std::optional<Value> &default_value = std::nullopt) const {
+        const auto position = lookup(key);
+        if (position != npos) {
+            return val_list[position];
+        }
+
+        if (!default_value) {
+            throw std::runtime_error("Key not found in dictionary and no default exists");
+        }
+
+        return default_value.value();
+    }
+
+    /// Assign `value` to `key`, inserting the key if it is not present
+    ///
+    /// @param key Dictionary key
+    /// @param value Value to assign
+    ///
+    /// @return Whether the key was inserted
+    template<typename M>
+    bool insert_or_assign(const Key &key, M &&value) {
+        const auto [position, inserted] = try_emplace_position(key, std::forward<M>(value));
+        if (!inserted) {
+            val_list[position] = std::forward<M>(value);
+        }
+        return inserted;
+    }
+
+    /// Insert `key` with a value constructed from `args`, if the key is not present
+    ///
+    /// @param key Dictionary key
+    /// @param args Arguments for the constructor of `Value`
+    ///
+    /// @return Whether the key was inserted
+    template<typename... Args>
+    bool try_emplace(const Key &key, Args &&... args) {
+        return try_emplace_position(key, std::forward<Args>(args)...).second;
+    }
+
+    /// Remove key from dictionary
+    ///
+    /// @param key Dictionary key
+    ///
+    /// @throws std::out_of_range If key not in dictionary
+    void del(const Key &key) {
+        del<Key>(key);
+    }
+
+    /// Remove key from dictionary (heterogeneous lookup)
+    ///
+    /// @param key Value comparable with the dictionary keys
+    ///
+    /// @throws std::out_of_range If key not in dictionary
+    template<typename K> requires is_lookup_key<K>
+    void del(const K &key) {
+        const auto position = lookup(key);
+        if (position == npos) {
+            throw std::out_of_range("Key not found in dictionary");
+        }
+
+        erase_position(position);
+    }
+
+    /// If the key is in the dictionary, remove it and return its value, else return the
+    /// default value. If no default value is given, an error is thrown.
+    ///
+    /// @param key Dictionary key
+    /// @param default_value Optional default value (default: `std::nullopt`)
+    ///
+    /// @throws std::runtime_error If key not in dictionary and no default value
+    ///
+    /// @return Value at key in dictionary if it exists, otherwise the default.
+    Value pop(const Key &key, std::optional<Value> default_value = std::nullopt) {
+        return pop<Key>(key, std::move(default_value));
+    }
+
+    /// If the key is in the dictionary, remove it and return its value, else return the
+    /// default value (heterogeneous lookup). If no default value is given, an error is thrown.
+    ///
+    /// @param key Value comparable with the dictionary keys
+    /// @param default_value Optional default value (default: `std::nullopt`)
+    ///
+    /// @throws std::runtime_error If key not in dictionary and no default value
+    ///
+    /// @return Value at key in dictionary if it exists, otherwise the default.
+    template<typename K> requires is_lookup_key<K>
+    Value pop(const K &key, std::optional<Value> default_value = std::nullopt) {
+        const auto position = lookup(key);
+        if (position != npos) {
+            Value value = std::move(val_list[position]);
+            erase_position(position);
+            return value;
+        }
+
+        if (!default_value) {
+            throw std::runtime_error("Key not found in dictionary and no default exists");
+        }
+
+        return std::move(*default_value);
+    }
+
+    /// Remove all items from the dictionary (which keeps its table of keys)
+    void clear() {
+        val_list.clear();
+    }
+
+    /// Get the size of the dictionary
+    ///
+    /// @return Number of keys
+    [[nodiscard]] size_t size() const {
+        return val_list.size();
+    }
+
+    /// Check if the dictionary is empty
+    ///
+    /// @return Whether the dictionary is empty
+    [[nodiscard]] bool empty() const {
+        return val_list.empty();
+    }
+
+    /// Get the keys of the dictionary, in insertion order
+    ///
+    /// @return View of the keys
+    KeysView keys() const {
+        return view<KeyAccess>(this);
+    }
+
+    /// Get the values of the dictionary, in insertion order
+    ///
+    /// @return View of the (`const`) values
+    ValuesView<true> values() const {
+        return view<ValueAccess>(this);
+    }
+
+    /// Get the values of the dictionary, in insertion order
+    ///
+    /// @return View of the values
+    ValuesView<false> values() {
+        return view<ValueAccess>(this);
+    }
+
+    /// Get the items of the dictionary, in insertion order
+    ///
+    /// @return View of the (`const`) items
+    ItemsView<true> items() const {
+        return view<ItemAccess>(this);
+    }
+
+    /// Get the items of the dictionary, in insertion order
+    ///
+    /// @return View of the items
+    ItemsView<false> items() {
+        return view<ItemAccess>(this);
+    }
+
+    /// Copy the items into an ordinary `Dict`
+    ///
+    /// @return Dictionary with the same items, in the same order
+    Dict<Key, Value, Hash, KeyEqual> to_dict() const {
+        Dict<Key, Value, Hash, KeyEqual> dict;
+        dict.reserve(val_list.size());
+        for (size_t i = 0; i < val_list.size(); ++i) {
+            dict.try_emplace(table->key(i), val_list[i]);
+        }
+        return dict;
+    }
+
+    /// Iterator to the first key
+    const_iterator begin() const {
+        return keys().begin();
+    }
+
+    /// Iterator past the last key
+    const_iterator end() const {
+        return keys().end();
+    }
+};
+
+/// Get the length (size) of a split dictionary
+///
+/// @tparam Key Dictionary key type
+/// @tparam Value Dictionary value type
+/// @tparam Hash Dictionary hash function
+/// @tparam KeyEqual Dictionary key comparison
+/// @param dict Dictionary
+///
+/// @return Length (size) of a dictionary (number of keys)
+template<typename Key, typename Value, typename Hash, typename KeyEqual>
+size_t len(const SplitDict<Key, Value, Hash, KeyEqual> &dict) {
+    return dict.size();
+}
+}
+
+#endif //DICTCPP_SPLIT_DICT_HPP
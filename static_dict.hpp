@@ -0,0 +1,400 @@
+#ifndef DICTCPP_STATIC_DICT_HPP
+#define DICTCPP_STATIC_DICT_HPP
+#include "dictcpp.hpp"
+
+#include <array>
+#include <limits>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+namespace dictcpp {
+/// Hash function usable in constant expressions, for the keys of a `StaticDict`: integers,
+/// enumerations and string views (hashed with FNV-1a). Define a specialisation (or pass another
+/// hash to `StaticDict`) for other key types.
+///
+/// @tparam Key Type of dictionary `keys`
+template<typename Key>
+struct StaticHash {
+    constexpr size_t operator()(const Key key) const noexcept requires std::is_integral_v<Key> || std::is_enum_v<Key> {
+        if constexpr (std::is_enum_v<Key>) {
+            return static_cast<size_t>(static_cast<std::underlying_type_t<Key> >(key));
+        } else {
+            return static_cast<size_t>(key);
+        }
+    }
+};
+
+/// Constant-expression hash function for string view keys (FNV-1a)
+///
+/// @tparam CharT Character type
+/// @tparam Traits Character traits
+template<typename CharT, typename Traits>
+struct StaticHash<std::basic_string_view<CharT, Traits> > {
+    constexpr size_t operator()(const std::basic_string_view<CharT, Traits> key) const noexcept {
+        uint64_t hash = 0xCBF29CE484222325;
+        for (const auto c: key) {
+            hash = (hash ^ static_cast<uint64_t>(static_cast<std::make_unsigned_t<CharT> >(c))) * 0x100000001B3;
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+
+/// A dictionary of at most `N` items which can be built and used in constant expressions, for
+/// lookup tables known at compile time. A `constexpr` (or `constinit`) `StaticDict` is built
+/// entirely by the compiler, including its hash index, so it costs nothing at program start-up,
+/// and lookups of constant keys are evaluated at compile time.
+///
+/// Items are stored in insertion order in fixed-size arrays (so `Key` and `Value` must be default
+/// constructible, and literal types for use in constant expressions), indexed by an
+/// open-addressing table of twice the capacity. Use `static_dict()` to deduce `N` from a list of
+/// items.
+///
+/// @tparam Key Type of dictionary `keys`
+/// @tparam Value Type of dictionary `values`
+/// @tparam N Maximum number of items
+/// @tparam Hash Hash function for keys, callable in constant expressions (default: `dictcpp::StaticHash<Key>`)
+/// @tparam KeyEqual Equality comparison for keys (default: `std::equal_to<>`)
+template<typename Key, typename Value, size_t N, typename Hash = StaticHash<Key>, typename KeyEqual = std::equal_to<> >
+class StaticDict {
+    // Fixed-capacity list, holding the first `count` elements of an array
+    template<typename T>
+    struct FixedList {
+        std::array<T, N> elements{};
+        size_t count = 0;
+
+        [[nodiscard]] constexpr size_t size() const {
+            return count;
+        }
+
+        constexpr T &operator[](const size_t i) {
+            return elements[i];
+        }
+
+        constexpr const T &operator[](const size_t i) const {
+            return elements[i];
+        }
+    };
+
+    // Positions in the lists are stored in the smallest type which can hold them
+    using Index = std::conditional_t<N < std::numeric_limits<uint8_t>::max(), uint8_t,
+        std::conditional_t<N < std::numeric_limits<uint16_t>::max(), uint16_t, uint32_t> >;
+    static_assert(N < std::numeric_limits<uint32_t>::max(), "StaticDict capacity is too large");
+
+    static constexpr Index empty_slot = std::numeric_limits<Index>::max();
+    // The table is at most half full, so probe sequences stay short
+    static constexpr size_t table_size = std::bit_ceil(2 * N + 1);
+
+    FixedList<Key> key_list;
+    FixedList<Value> val_list;
+    std::array<Index, table_size> index_table = make_empty_table();
+    [[no_unique_address]] Hash hasher;
+    [[no_unique_address]] KeyEqual key_equal;
+    size_t used = 0;
+
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+    static constexpr size_t head = 0;
+
+    static constexpr std::array<Index, table_size> make_empty_table() {
+        std::array<Index, table_size> table{};
+        for (auto &slot: table) {
+            slot = empty_slot;
+        }
+        return table;
+    }
+
+    // As for `Dict`, the hash is mixed so that regular keys (e.g. consecutive integers) spread
+    // over the table
+    static constexpr size_t mix(size_t hash) {
+        hash *= static_cast<size_t>(0x9E3779B97F4A7C15);
+        return hash ^ (hash >> (std::numeric_limits<size_t>::digits / 2));
+    }
+
+    // Slot holding `key`, or the empty slot where it would be inserted (linear probing)
+    constexpr size_t find_slot(const Key &key) const {
+        auto slot = mix(hasher(key)) & (table_size - 1);
+        while (index_table[slot] != empty_slot && !key_equal(key_list[index_table[slot]], key)) {
+            slot = (slot + 1) & (table_size - 1);
+        }
+        return slot;
+    }
+
+    constexpr size_t lookup(const Key &key) const {
+        const auto index = index_table[find_slot(key)];
+        return index == empty_slot ? npos : index;
+    }
+
+    constexpr size_t next_live(const size_t index) const {
+        return index + 1;
+    }
+
+    constexpr size_t previous_live(const size_t index) const {
+        return index - 1;
+    }
+
+    [[nodiscard]] constexpr bool is_compact() const {
+        return true;
+    }
+
+    template<typename DictType, typename Access>
+    friend class DictIterator;
+
+    template<typename DictType, typename Access>
+    friend class DictView;
+
+    struct KeyAccess {
+        static constexpr const Key &get(const StaticDict *dict, const size_t index) {
+            return dict->key_list[index];
+        }
+    };
+
+    struct ValueAccess {
+        static constexpr const Value &get(const StaticDict *dict, const size_t index) {
+            return dict->val_list[index];
+        }
+    };
+
+    struct ItemAccess {
+        static constexpr Item<const Key &, const Value &> get(const StaticDict *dict, const size_t index) {
+            return {dict->key_list[index], dict->val_list[index]};
+        }
+    };
+
+public:
+    /// Iterator through the keys of a dictionary
+    using const_iterator = DictIterator<const StaticDict, KeyAccess>;
+    using iterator = const_iterator;
+
+    /// View of the dictionary keys
+    using KeysView = DictView<const StaticDict, KeyAccess>;
+
+    /// View of the dictionary values
+    using ValuesView = DictView<const StaticDict, ValueAccess>;
+
+    /// View of the dictionary items, given as `Item`s of references to each key and value
+    using ItemsView = DictView<const StaticDict, ItemAccess>;
+
+    /// Iterator through the dictionary items, as returned by `find()`
+    using const_item_iterator = typename ItemsView::iterator;
+
+    /// Maximum number of items
+    static constexpr size_t max_size = N;
+
+    /// Initialise an empty dictionary
+    constexpr StaticDict() = default;
+
+    /// Initialise a dictionary using a list of `Item`s. As for `Dict`, a repeated key keeps its
+    /// first position and its last value.
+    ///
+    /// @param key_values A list of dictionary `Item`s (key-value pair)
+    ///
+    /// @throws std::length_error If there are more than `N` distinct keys (a compilation error in a constant expression)
+    constexpr StaticDict(const std::initializer_list<Item<Key, Value>> &key_values) {
+        for (const auto &[key, value]: key_values) {
+            insert_or_assign(key, value);
+        }
+    }
+
+    /// Initialise a dictionary using an array of `Item`s
+    ///
+    /// @param key_values Key-value pairs in an array
+    ///
+    /// @throws std::length_error If there are more than `N` distinct keys
+    template<size_t M>
+    constexpr explicit StaticDict(const std::array<Item<Key, Value>, M> &key_values) {
+        for (const auto &[key, value]: key_values) {
+            insert_or_assign(key, value);
+        }
+    }
+
+    /// Assign `value` to `key`, inserting the key if it is not present
+    ///
+    /// @param key Dictionary key
+    /// @param value Value to assign
+    ///
+    /// @throws std::length_error If the key is not present and the dictionary is full
+    ///
+    /// @return Whether the key was inserted
+    constexpr bool insert_or_assign(const Key &key, const Value &value) {
+        const auto slot = find_slot(key);
+        if (index_table[slot] != empty_slot) {
+            val_list[index_table[slot]] = value;
+            return false;
+        }
+        if (used == N) {
+            throw std::length_error("StaticDict is full");
+        }
+
+        index_table[slot] = static_cast<Index>(used);
+        key_list[used] = key;
+        val_list[used] = value;
+        key_list.count = val_list.count = ++used;
+        return true;
+    }
+
+    /// Access value at key `key`
+    ///
+    /// @param key Dictionary key
+    ///
+    /// @throws std::out_of_range If key not in dictionary (a compilation error in a constant expression)
+    ///
+    /// @return Constant reference to value at `dict[key]`
+    constexpr const Value &operator[](const Key &key) const {
+        return at(key);
+    }
+
+    /// Access value at `key` (wrapper to `operator[]`)
+    ///
+    /// @param key Dictionary key
+    ///
+    /// @throws std::out_of_range If key not in dictionary
+    ///
+    /// @return Constant reference to value at `dict[key]`
+    constexpr const Value &at(const Key &key) const {
+        const auto index = lookup(key);
+        if (index == npos) {
+            throw std::out_of_range("Key not found in dictionary");
+        }
+
+        return val_list[index];
+    }
+
+    /// Check if dictionary contains `key`
+    ///
+    /// @param key A possible key
+    ///
+    /// @return Whether key is present in dictionary
+    constexpr bool contains(const Key &key) const {
+        return lookup(key) != npos;
+    }
+
+    /// Get value from dictionary at key `key`
+    ///
+    /// @param key Dictionary key
+    /// @param default_value Optional default (default: `std::nullopt`)
+    ///
+    /// @throws std::runtime_error If key not in dictionary and no default value is specified
+    ///
+    /// @return Value at key, if present, default value otherwise
+    constexpr Value get(const Key &key, const std::optional<Value> &default_value = std::nullopt) const {
+        const auto index = lookup(key);
+        if (index != npos) {
+            return val_list[index];
+        }
+
+        if (!default_value) {
+            throw std::runtime_error("Key not found in dictionary and no default exists");
+        }
+
+        return default_value.value();
+    }
+
+    /// Find the item with key `key`
+    ///
+    /// @param key Dictionary key
+    ///
+    /// @return Iterator to the item, or `items().end()` if the key is not in the dictionary
+    constexpr const_item_iterator find(const Key &key) const {
+        const auto index = lookup(key);
+        return {this, index == npos ? used : index};
+    }
+
+    /// Get the size of the dictionary
+    ///
+    /// @return Number of keys
+    [[nodiscard]] constexpr size_t size() const {
+        return used;
+    }
+
+    /// Check if the dictionary is empty
+    ///
+    /// @return Whether the dictionary is empty
+    [[nodiscard]] constexpr bool empty() const {
+        return used == 0;
+    }
+
+    /// Get the keys of the dictionary, in insertion order
+    ///
+    /// @return View of the keys
+    constexpr KeysView keys() const {
+        return KeysView(this);
+    }
+
+    /// Get the values of the dictionary, in insertion order
+    ///
+    /// @return View of the values
+    constexpr ValuesView values() const {
+        return ValuesView(this);
+    }
+
+    /// Get the items of the dictionary, in insertion order
+    ///
+    /// @return View of the items
+    constexpr ItemsView items() const {
+        return ItemsView(this);
+    }
+
+    /// Iterator to the first key
+    constexpr const_iterator begin() const {
+        return keys().begin();
+    }
+
+    /// Iterator past the last key
+    constexpr const_iterator end() const {
+        return keys().end();
+    }
+};
+
+/// Initialise a `StaticDict` with capacity for exactly the items of a list, in a constant
+/// expression if possible, e.g.
+/// `constexpr auto codes = dictcpp::static_dict<std::string_view, int>({{"ok", 200}, {"not found", 404}});`
+///
+/// @tparam Key Dictionary key type
+/// @tparam Value Dictionary value type
+/// @tparam N Number of items
+/// @param items Input list
+///
+/// @return Dictionary
+template<typename Key, typename Value, size_t N>
+constexpr StaticDict<Key, Value, N> static_dict(const Item<Key, Value> (&items)[N]) {
+    StaticDict<Key, Value, N> dict;
+    for (const auto &[key, value]: items) {
+        dict.insert_or_assign(key, value);
+    }
+    return dict;
+}
+
+/// Get the keys of a static dictionary as a vector
+///
+/// @tparam Key Dictionary key type
+/// @tparam Value Dictionary value type
+/// @tparam N Maximum number of items
+/// @tparam Hash Dictionary hash function
+/// @tparam KeyEqual Dictionary key comparison
+/// @param dict Dictionary
+///
+/// @return Vector of keys
+template<typename Key, typename Value, size_t N, typename Hash, typename KeyEqual>
+std::vector<Key> list(const StaticDict<Key, Value, N, Hash, KeyEqual> &dict) {
+    return std::vector<Key>(dict.begin(), dict.end());
+}
+
+/// Get the length (size) of a static dictionary
+///
+/// @tparam Key Dictionary key type
+/// @tparam Value Dictionary value type
+/// @tparam N Maximum number of items
+/// @tparam Hash Dictionary hash function
+/// @tparam KeyEqual Dictionary key comparison
+/// @param dict Dictionary
+///
+/// @return Length (size) of a dictionary (number of keys)
+template<typename Key, typename Value, size_t N, typename Hash, typename KeyEqual>
+constexpr size_t len(const StaticDict<Key, Value, N, Hash, KeyEqual> &dict) {
+    return dict.size();
+}
+}
+
+#endif //DICTCPP_STATIC_DICT_HPP
@@ -0,0 +1,139 @@
+#include "dictcpp.hpp"
+
+#include "catch.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+using dictcpp::Dict;
+
+namespace {
+// Memory resource counting the bytes currently allocated from it
+class CountingResource : public std::pmr::memory_resource {
+    void *do_allocate(const std::size_t bytes, const std::size_t alignment) override {
+        allocated += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, const std::size_t bytes, const std::size_t alignment) override {
+        allocated -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+
+public:
+    std::size_t allocated = 0;
+};
+
+// Sets the default memory resource to one which cannot allocate, for the lifetime of the object
+struct NoDefaultResource {
+    std::pmr::memory_resource *previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+
+    ~NoDefaultResource() {
+        std::pmr::set_default_resource(previous);
+    }
+};
+
+std::pmr::string long_string(const int i,
+                             std::pmr::memory_resource *resource = std::pmr::get_default_resource()) {
+    auto string = std::pmr::string("a string too long for the small string optimisation ", resource);
+    string += std::to_string(i);
+    return string;
+}
+}
+
+TEST_CASE("Dictionary in an arena") {
+    std::vector<std::byte> buffer(1 << 20);
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    const NoDefaultResource no_default;
+
+    // Any allocation outside the arena would throw
+    auto dict = dictcpp::pmr::Dict<std::pmr::string, int>(&arena);
+    for (int i = 0; i < 1000; ++i) {
+        dict[long_string(i, &arena)] = i;
+    }
+    REQUIRE(dict.size() == 1000);
+    CHECK(dict.at(long_string(500, &arena)) == 500);
+    CHECK(dict.keys().front().get_allocator().resource() == &arena);
+    CHECK(dict.get_allocator().resource() == &arena);
+
+    dict.del(long_string(0, &arena));
+    CHECK(dict.pop(long_string(1, &arena)) == 1);
+    dict.compact();
+    CHECK(dict.size() == 998);
+
+    const auto copy = dict.copy();
+    CHECK(copy.get_allocator().resource() == &arena);
+    CHECK(copy.at(long_string(999, &arena)) == 999);
+}
+
+TEST_CASE("Storage is returned to the memory resource") {
+    CountingResource resource;
+    {
+        auto dict = dictcpp::pmr::Dict<int, std::pmr::string>(&resource);
+        for (int i = 0; i < 100; ++i) {
+            dict[i] = long_string(i);
+        }
+        CHECK(resource.allocated > 0);
+        CHECK(dict.values().back().get_allocator().resource() == &resource);
+
+        dict.clear();
+        CHECK(resource.allocated == 0);
+
+        dict[1] = long_string(1);
+        dict.update({{2, long_string(2)}, {3, long_string(3)}});
+    }
+    CHECK(resource.allocated == 0);
+}
+
+TEST_CASE("Moving between memory resources") {
+    CountingResource first;
+    CountingResource second;
+
+    auto dict = dictcpp::pmr::Dict<int, std::pmr::string>(&first);
+    for (int i = 0; i < 100; ++i) {
+        dict[i] = long_string(i);
+    }
+
+    // Same resource: the storage is taken over
+    const auto allocated = first.allocated;
+    auto same = dictcpp::pmr::Dict<int, std::pmr::string>(std::move(dict), &first);
+    CHECK(first.allocated == allocated);
+    CHECK(dict.empty());
+
+    // Different resource: the items are moved into new storage
+    auto other = dictcpp::pmr::Dict<int, std::pmr::string>(std::move(same), &second);
+    CHECK(same.empty());
+    CHECK(first.allocated == 0);
+    CHECK(second.allocated > 0);
+    REQUIRE(other.size() == 100);
+    CHECK(other.at(42) == long_string(42));
+    CHECK(dictcpp::list(other).back() == 99);
+
+    // Assignment keeps the resource of the assigned dictionary
+    dict = other;
+    CHECK(dict.get_allocator().resource() == &first);
+    CHECK(dict.at(99) == long_string(99));
+    CHECK(first.allocated > 0);
+    other = std::move(dict);
+    CHECK(other.get_allocator().resource() == &second);
+    CHECK(other.size() == 100);
+}
+
+TEST_CASE("Copy with allocator") {
+    CountingResource resource;
+    const auto dict = Dict<int, int>{{1, 1}, {2, 2}};
+    using PmrDict = dictcpp::pmr::Dict<int, int, dictcpp::Hash<int>, std::equal_to<>, 0>;
+
+    const auto source = PmrDict{{1, 10}, {2, 20}, {3, 30}};
+    const auto copy = PmrDict(source, &resource);
+    CHECK(resource.allocated > 0);
+    CHECK(copy.at(3) == 30);
+    CHECK(dictcpp::len(copy) == 3);
+    CHECK(dict.get_allocator() == std::allocator<dictcpp::Item<int, int> >());
+}
@@ -0,0 +1,82 @@
+#include "dictcpp.hpp"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using dictcpp::Dict;
+
+TEST_CASE("Boolean values are packed") {
+    Dict<int, bool> flags;
+    for (int i = 0; i < 1000; ++i) {
+        flags[i] = i % 3 == 0;
+    }
+    CHECK(flags.size() == 1000);
+    CHECK(flags.count() == 334);
+    CHECK(flags[3]);
+    CHECK_FALSE(flags.at(4));
+    CHECK(flags.get(5, true) == false);
+    CHECK(flags.get(-1, true) == true);
+
+    // Proxy references assign the bit
+    flags[4] = true;
+    flags.at(3) = false;
+    auto reference = flags[5];
+    reference = flags[4];
+    CHECK(flags[5]);
+    CHECK_FALSE(flags[3]);
+    CHECK(flags.count() == 335);
+
+    for (auto &&[key, value]: flags.items()) {
+        value = key < 10;
+    }
+    CHECK(flags.count() == 10);
+    CHECK(std::ranges::count(flags.values(), true) == 10);
+    const auto &const_flags = flags;
+    CHECK(std::ranges::count(const_flags.values(), true) == 10);
+    CHECK(flags.find(7)->value);
+    CHECK(flags.values()[9]);
+    CHECK_FALSE(flags.values()[10]);
+
+    // Deleted values are not counted
+    for (int i = 0; i < 1000; i += 2) {
+        CHECK(flags.pop(i) == (i < 10));
+    }
+    CHECK(flags.count() == 5);
+    flags.flip();
+    CHECK(flags.count() == 495);
+    CHECK(flags.any());
+    CHECK_FALSE(flags.all());
+    CHECK_FALSE(flags.none());
+    flags.compact();
+    CHECK(flags.count() == 495);
+    CHECK(flags[11]);
+    CHECK_FALSE(flags[9]);
+
+    Dict<int, bool> moved(std::move(flags));
+    CHECK(moved.count() == 495);
+    CHECK(flags.none());
+    CHECK(flags.all());
+}
+
+TEST_CASE("Small boolean dictionaries") {
+    Dict<std::string, bool> features{{"dark_mode", true}, {"beta", false}, {"search", true}};
+    CHECK(features.count() == 2);
+    features.del("dark_mode");
+    CHECK(std::ranges::equal(features.values(), std::vector{false, true}));
+    CHECK(features.setdefault("export", true));
+    CHECK(features.popitem().key == "export");
+
+    features.flip();
+    CHECK(features["beta"]);
+    CHECK_FALSE(features["search"]);
+    features.update(Dict<std::string, bool>{{"search", true}, {"new", true}});
+    CHECK(features.all());
+
+    auto copy = features.copy();
+    copy["beta"] = false;
+    CHECK(features["beta"]);
+    CHECK(copy.count() == 2);
+}
@@ -0,0 +1,247 @@
+#include "concurrent_dict.hpp"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using dictcpp::ConcurrentDict;
+
+namespace {
+constexpr int thread_count = 8;
+
+// Run `function(thread_index)` on each of `thread_count` threads and wait for them to finish
+template<typename Function>
+void run_threads(Function function) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back(function, t);
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+}
+
+template<typename D, typename K>
+concept CanLookUp = requires(D &dict, const K &key) {
+    dict.contains(key);
+    dict.get(key);
+    dict.visit(key, [](const int &) {});
+    dict.update(key, [](int &) {});
+    dict.pop(key);
+    dict.del(key);
+};
+}
+
+TEST_CASE("Concurrent dictionary operations") {
+    auto dict = ConcurrentDict<std::string, int>({{"a", 1}, {"b", 2}}, 5);
+    CHECK(dict.shard_count() == 8);
+    CHECK(dict.size() == 2);
+
+    CHECK(dict.get("a") == 1);
+    CHECK_FALSE(dict.get("c").has_value());
+    CHECK(dict.get("c", 3) == 3);
+    CHECK(dict.contains("b"));
+
+    CHECK(dict.insert_or_assign("c", 3));
+    CHECK_FALSE(dict.insert_or_assign("c", 4));
+    CHECK_FALSE(dict.try_emplace("c", 5));
+    CHECK(dict.get("c") == 4);
+
+    CHECK(dict.setdefault("d", 6) == 6);
+    CHECK(dict.setdefault("d", 7) == 6);
+    CHECK(dict.upsert("d", [](int &n) { n *= 2; }) == 12);
+    CHECK(dict.update("a", [](int &n) { n = 10; }));
+    CHECK_FALSE(dict.update("z", [](int &n) { n = 10; }));
+
+    int visited = 0;
+    CHECK(dict.visit("a", [&](const int &n) { visited = n; }));
+    CHECK(visited == 10);
+
+    int calls = 0;
+    CHECK(dict.compute_if_absent("a", [&] { return ++calls; }) == 10);
+    CHECK(dict.compute_if_absent("e", [&] { return ++calls; }) == 1);
+    CHECK(calls == 1);
+
+    CHECK(dict.pop("e") == 1);
+    CHECK_FALSE(dict.pop("e").has_value());
+    CHECK(dict.pop("e", 0) == 0);
+    dict.del("d");
+    CHECK_THROWS_AS(dict.del("d"), std::out_of_range);
+    CHECK(dict.size() == 3);
+
+    dict.update(dictcpp::Dict<std::string, int>({{"b", 20}, {"f", 30}}));
+    CHECK(dict.get("b") == 20);
+    const auto snapshot = dict.snapshot();
+    CHECK(std::ranges::equal(snapshot.keys(), std::vector<std::string>{"a", "b", "c", "f"}));
+    CHECK(std::ranges::equal(snapshot.values(), std::vector{10, 20, 4, 30}));
+
+    dict.clear();
+    CHECK(dict.empty());
+    CHECK(dict.snapshot().empty());
+}
+
+namespace {
+// Hash counting its calls
+struct CountingHash {
+    static inline size_t calls = 0;
+
+    size_t operator()(const int key) const {
+        calls++;
+        return std::hash<int>{}(key);
+    }
+};
+}
+
+TEST_CASE("Heterogeneous lookups in a concurrent dictionary") {
+    auto dict = ConcurrentDict<std::string, int>({{"a", 1}, {"b", 2}});
+    CHECK(dict.contains(std::string_view("a")));
+    CHECK(dict.get(std::string_view("b")) == 2);
+    CHECK(dict.update(std::string_view("a"), [](int &n) { n += 10; }));
+    CHECK(dict.pop(std::string_view("a")) == 11);
+    CHECK(dict.pop(std::string_view("a"), 0) == 0);
+
+    // Without a transparent hash, keys are converted to `Key` at the call, and other types of
+    // keys are rejected there
+    using Plain = ConcurrentDict<std::string, int, std::hash<std::string> >;
+    Plain plain({{"a", 1}});
+    CHECK(plain.get("a") == 1);
+    CHECK(plain.visit("a", [](const int &n) { CHECK(n == 1); }));
+    static_assert(CanLookUp<ConcurrentDict<std::string, int>, std::string_view>);
+    static_assert(!CanLookUp<Plain, std::string_view>);
+}
+
+TEST_CASE("Keys are hashed once per operation") {
+    ConcurrentDict<int, int, CountingHash> dict(2);
+    for (int i = 0; i < 1000; ++i) {
+        dict.insert_or_assign(i, i);
+    }
+    CHECK(CountingHash::calls == 1000);
+
+    CountingHash::calls = 0;
+    CHECK(dict.get(10) == 10);
+    CHECK(dict.setdefault(10, 0) == 10);
+    CHECK(dict.setdefault(1000, 7) == 7);
+    CHECK(dict.upsert(1000, [](int &n) { n++; }) == 8);
+    CHECK(dict.compute_if_absent(1001, [] { return 9; }) == 9);
+    CHECK(dict.pop(1001) == 9);
+    CHECK_FALSE(dict.pop(1001).has_value());
+    CHECK(CountingHash::calls == 7);
+    CHECK(dict.size() == 1001);
+}
+
+TEST_CASE("Snapshots are in insertion order") {
+    ConcurrentDict<int, int> dict;
+    for (int i = 1000; i > 0; --i) {
+        dict.insert_or_assign(i, -i);
+    }
+    dict.pop(500);
+    dict.insert_or_assign(500, 0);
+
+    const auto snapshot = dict.snapshot();
+    REQUIRE(snapshot.size() == 1000);
+    CHECK(snapshot.keys().front() == 1000);
+    CHECK(snapshot.keys().back() == 500);
+    CHECK(snapshot.at(1) == -1);
+}
+
+TEST_CASE("Concurrent writers") {
+    ConcurrentDict<int, int> dict;
+    constexpr int per_thread = 10000;
+
+    run_threads([&](const int t) {
+        for (int i = 0; i < per_thread; ++i) {
+            dict.insert_or_assign(t * per_thread + i, t);
+        }
+    });
+    REQUIRE(dict.size() == thread_count * per_thread);
+
+    // Every thread erases a different half of the keys, while all threads read
+    std::atomic<int> found = 0;
+    run_threads([&](const int t) {
+        for (int i = 0; i < per_thread; i += 2) {
+            CHECK(dict.pop(t * per_thread + i) == t);
+        }
+        for (int i = 1; i < per_thread; i += 2) {
+            found += dict.contains(((t + 1) % thread_count) * per_thread + i);
+        }
+    });
+    CHECK(found == thread_count * per_thread / 2);
+    CHECK(dict.size() == thread_count * per_thread / 2);
+    CHECK(dict.snapshot().size() == dict.size());
+}
+
+TEST_CASE("Concurrent readers of a shard") {
+    ConcurrentDict<int, int> dict(1);
+    for (int i = 0; i < 1000; ++i) {
+        dict.insert_or_assign(i, -i);
+    }
+
+    std::atomic<int> found = 0;
+    run_threads([&](int) {
+        for (int i = 0; i < 2000; ++i) {
+            found += dict.contains(i);
+            found += dict.get(i).has_value();
+        }
+    });
+    CHECK(found == thread_count * 2 * 1000);
+}
+
+TEST_CASE("Compound operations are atomic") {
+    ConcurrentDict<int, int> dict(4);
+    std::atomic<int> calls = 0;
+    constexpr int keys = 100;
+    constexpr int rounds = 1000;
+
+    run_threads([&](int) {
+        for (int i = 0; i < rounds; ++i) {
+            const int key = i % keys;
+            dict.upsert(key, [](int &n) { n++; });
+            dict.compute_if_absent(keys + key, [&] { return ++calls; });
+        }
+    });
+
+    CHECK(calls == keys);
+    for (int key = 0; key < keys; ++key) {
+        CHECK(dict.get(key) == thread_count * rounds / keys);
+    }
+
+    // Only one thread can pop each key
+    std::atomic<int> popped = 0;
+    run_threads([&](int) {
+        for (int key = 0; key < keys; ++key) {
+            popped += dict.pop(key).has_value();
+        }
+    });
+    CHECK(popped == keys);
+    CHECK(dict.size() == keys);
+}
+
+TEST_CASE("Snapshots while writing") {
+    ConcurrentDict<int, int> dict;
+    std::atomic<bool> done = false;
+
+    // Keys are inserted in increasing order, so every snapshot must be a prefix of the keys
+    std::thread writer([&] {
+        for (int i = 0; i < 20000; ++i) {
+            dict.insert_or_assign(i, i);
+        }
+        done = true;
+    });
+
+    while (!done) {
+        const auto snapshot = dict.snapshot();
+        int expected = 0;
+        for (const auto key: snapshot.keys()) {
+            if (key != expected++) {
+                FAIL("Snapshot is not a prefix of the insertions");
+            }
+        }
+    }
+    writer.join();
+    CHECK(dict.snapshot().size() == 20000);
+}
@@ -111,3 +111,64 @@ TEST_CASE("Clear") {
     CHECK(dict.values().empty());
     CHECK(dict.items().empty());
 }
+
+TEST_CASE("Deletions keep insertion order") {
+    auto dict = Dict<int, int>();
+    constexpr int n = 1000;
+    for (int i = 0; i < n; ++i) {
+        dict[i] = -i;
+    }
+
+    // Delete from the front, so that entries are never dropped from the back
+    for (int i = 0; i < n / 4; ++i) {
+        dict.del(i);
+        REQUIRE(dict.size() == static_cast<size_t>(n - i - 1));
+        REQUIRE(*dict.begin() == i + 1);
+    }
+
+    int expected = n / 4;
+    for (const auto &key: dict) {
+        CHECK(key == expected++);
+    }
+    CHECK(expected == n);
+
+    // Re-inserting a deleted key places it at the end
+    dict[0] = 100;
+    CHECK(dict.keys().back() == 0);
+    CHECK(dict.at(0) == 100);
+    CHECK(dict.at(n / 4) == -n / 4);
+
+    dict.compact();
+    const auto keys = dict.keys();
+    REQUIRE(keys.size() == n - n / 4 + 1);
+    CHECK(keys.front() == n / 4);
+    CHECK(keys.back() == 0);
+    for (int i = n / 4; i < n; ++i) {
+        CHECK(dict.at(i) == -i);
+    }
+}
+
+TEST_CASE("Drain dictionary") {
+    auto dict = Dict<int, char>();
+    for (int i = 0; i < 100; ++i) {
+        dict[i] = static_cast<char>('a' + i % 26);
+    }
+
+    for (int i = 0; i < 100; i += 2) {
+        dict.del(i);
+    }
+    REQUIRE(dict.size() == 50);
+
+    for (int i = 99; i > 0; i -= 2) {
+        const auto [key, value] = dict.popitem();
+        CHECK(key == i);
+        CHECK(value == static_cast<char>('a' + i % 26));
+    }
+    REQUIRE(dict.empty());
+    CHECK(dict.begin() == dict.end());
+
+    dict[5] = 'x';
+    REQUIRE(dict.size() == 1);
+    CHECK(dict.at(5) == 'x');
+    CHECK_FALSE(dict.contains(4));
+}
@@ -235,3 +235,193 @@ TEST_CASE("Copy") {
     CHECK_FALSE(dict2.contains('e'));
     CHECK(dict2.at('f') == 11);
 }
+
+TEST_CASE("Large dictionary") {
+    auto dict = Dict<int, int>();
+    constexpr int n = 10000;
+
+    // Multiples of a power of two share their low bits, which exercises the probing
+    for (int i = 0; i < n; ++i) {
+        dict[i * 1024] = i;
+    }
+    REQUIRE(dict.size() == n);
+
+    for (int i = 0; i < n; ++i) {
+        REQUIRE(dict.contains(i * 1024));
+        CHECK(dict.at(i * 1024) == i);
+        CHECK_FALSE(dict.contains(i * 1024 + 1));
+    }
+
+    const auto keys = dict.keys();
+    for (int i = 0; i < n; ++i) {
+        CHECK(keys[i] == i * 1024);
+    }
+
+    for (int i = 0; i < n; i += 2) {
+        dict.del(i * 1024);
+    }
+    REQUIRE(dict.size() == n / 2);
+
+    for (int i = 0; i < n; ++i) {
+        CHECK(dict.contains(i * 1024) == (i % 2 == 1));
+    }
+
+    const auto odd_keys = dict.keys();
+    for (int i = 0; i < n / 2; ++i) {
+        CHECK(odd_keys[i] == (2 * i + 1) * 1024);
+    }
+}
+
+TEST_CASE("Views") {
+    auto dict = Dict<char, int>{
+        {'a', 1},
+        {'b', 2},
+        {'c', 3}
+    };
+
+    using ItemsView = decltype(dict.items());
+    static_assert(std::ranges::random_access_range<decltype(dict.keys())>);
+    static_assert(std::ranges::random_access_range<decltype(dict.values())>);
+    static_assert(std::ranges::random_access_range<ItemsView>);
+    static_assert(std::ranges::random_access_range<decltype(std::as_const(dict).items())>);
+    static_assert(std::ranges::sized_range<ItemsView>);
+    static_assert(std::ranges::view<ItemsView>);
+
+    const auto keys = dict.keys();
+    const auto values = dict.values();
+    REQUIRE(keys.size() == 3);
+    REQUIRE(values.size() == 3);
+
+    // Views reflect later changes to the dictionary
+    dict['d'] = 4;
+    dict.del('a');
+    REQUIRE(keys.size() == 3);
+    CHECK(keys[0] == 'b');
+    CHECK(keys[2] == 'd');
+    CHECK(values[2] == 4);
+    CHECK(keys.front() == 'b');
+    CHECK(keys.back() == 'd');
+
+    // Values are modifiable through a view of a non-const dictionary
+    for (auto &value: dict.values()) {
+        value *= 10;
+    }
+    for (auto &&[key, value]: dict.items()) {
+        value += 1;
+    }
+    CHECK(dict.at('b') == 21);
+    CHECK(dict.at('c') == 31);
+    CHECK(dict.at('d') == 41);
+
+    CHECK(std::ranges::count_if(dict.values(), [](const int value) { return value > 25; }) == 2);
+    CHECK(*std::ranges::find(dict.keys(), 'c') == 'c');
+
+    const auto &const_dict = dict;
+    int total = 0;
+    for (const auto &[key, value]: const_dict.items()) {
+        static_assert(std::is_const_v<std::remove_reference_t<decltype(value)> >);
+        total += value;
+    }
+    CHECK(total == 93);
+}
+
+TEST_CASE("Random access views") {
+    Dict<int, int> dict;
+    for (int i = 0; i < 100; ++i) {
+        dict[i] = i * 2;
+    }
+
+    // Items are proxies of references, bound without copies
+    for (auto &&[key, value]: dict.items()) {
+        value = key;
+    }
+    CHECK(dict.at(42) == 42);
+
+    const auto items = dict.items();
+    auto it = items.begin();
+    CHECK((it + 10)->key == 10);
+    CHECK(it[20].value == 20);
+    CHECK(items.end() - it == 100);
+    CHECK(it < it + 1);
+    it += 50;
+    CHECK(it->key == 50);
+    it -= 25;
+    CHECK((*it).key == 25);
+    CHECK(items[99].key == 99);
+    CHECK(items.back().key == 99);
+
+    // Items are independent of the iterators which give them (multipass)
+    const auto first = *it;
+    const auto next = it[1];
+    CHECK(first.key == 25);
+    CHECK(next.key == 26);
+
+    // Deleted entries are skipped
+    for (int i = 0; i < 100; i += 2) {
+        dict.del(i);
+    }
+    CHECK(items.end() - items.begin() == 50);
+    CHECK((items.begin() + 10)->key == 21);
+    CHECK((items.end() - 1)->key == 99);
+    CHECK(items.begin()[3].key == 7);
+    CHECK(std::ranges::distance(dict.keys()) == 50);
+
+    int expected = 99;
+    for (auto [key, value]: items | std::views::reverse) {
+        CHECK(key == expected);
+        value = -key;
+        expected -= 2;
+    }
+    CHECK(dict.at(51) == -51);
+    CHECK(std::make_reverse_iterator(items.end())->key == 99);
+    CHECK(std::make_reverse_iterator(items.end())[1].key == 97);
+    CHECK(std::ranges::is_sorted(dict.keys() | std::views::reverse, std::greater<>()));
+}
+
+TEST_CASE("Reserve") {
+    auto dict = Dict<int, int>();
+    CHECK(dict.capacity() == Dict<int, int>::inline_capacity);
+
+    dict.reserve(1000);
+    REQUIRE(dict.capacity() >= 1000);
+    const auto capacity = dict.capacity();
+
+    for (int i = 0; i < 1000; ++i) {
+        dict[i] = i;
+    }
+    CHECK(dict.capacity() == capacity);
+
+    for (int i = 0; i < 990; ++i) {
+        dict.del(i);
+    }
+    dict.shrink_to_fit();
+    REQUIRE(dict.size() == 10);
+    CHECK(dict.capacity() >= 10);
+    CHECK(dict.capacity() < capacity);
+    for (int i = 990; i < 1000; ++i) {
+        CHECK(dict.at(i) == i);
+    }
+    CHECK(dict.keys().front() == 990);
+
+    dict.clear();
+    dict.shrink_to_fit();
+    CHECK(dict.capacity() == Dict<int, int>::inline_capacity);
+}
+
+TEST_CASE("Bulk initialiser with repeated keys") {
+    std::vector<Item<int>> values;
+    for (int i = 0; i < 10000; ++i) {
+        values.emplace_back(i % 1000, i);
+    }
+
+    const auto dict = Dict(values);
+    REQUIRE(dict.size() == 1000);
+
+    // Each key keeps its first position and its last value
+    int expected = 0;
+    for (const auto &[key, value]: dict.items()) {
+        CHECK(key == expected);
+        CHECK(value == 9000 + expected);
+        expected++;
+    }
+}
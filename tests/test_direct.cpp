@@ -53,13 +53,15 @@ TEST_CASE("Loop through non-const dictionary") {
         CHECK(dictionary_keys[i] == keys[i]);
     }
 
-    for (auto &key: dictionary) {
-        key = key + 3;
-    }
+    // Keys are part of the hash index, so iteration only gives constant access
+    static_assert(std::is_const_v<std::remove_reference_t<decltype(*dictionary.begin())>>);
 
-    const auto new_keys = dictionary.keys();
-    REQUIRE(new_keys.size() == dictionary.size());
-    for (size_t i = 0; i < new_keys.size(); ++i) {
-        CHECK(new_keys[i] == keys[i] + 3);
+    for (const auto &key: dictionary) {
+        dictionary[key] += 3;
     }
+
+    REQUIRE(dictionary.size() == keys.size());
+    CHECK(dictionary[1] == 23);
+    CHECK(dictionary[2] == 33);
+    CHECK(dictionary[3] == 53);
 }
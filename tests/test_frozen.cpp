@@ -0,0 +1,151 @@
+#include "frozen_dict.hpp"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using dictcpp::Dict;
+using dictcpp::FrozenDict;
+
+TEST_CASE("Frozen dictionary lookups") {
+    const auto dict = FrozenDict<std::string, int>({{"one", 1}, {"two", 2}, {"three", 3}, {"one", 10}});
+
+    CHECK(dict.size() == 3);
+    CHECK(dictcpp::len(dict) == 3);
+    CHECK(dict["one"] == 10);
+    CHECK(dict.at(std::string("two")) == 2);
+    CHECK(dict.at(std::string_view("three")) == 3);
+    CHECK_THROWS_AS(dict.at("four"), std::out_of_range);
+
+    CHECK(dict.contains("two"));
+    CHECK_FALSE(dict.contains("four"));
+    CHECK(dict.get("four", 4) == 4);
+    CHECK_THROWS_AS(dict.get("four"), std::runtime_error);
+
+    CHECK(dict.find("three")->value == 3);
+    CHECK(dict.find("four") == dict.items().end());
+
+    // Insertion order is kept, with the first position of a repeated key
+    CHECK(dictcpp::list(dict) == std::vector<std::string>{"one", "two", "three"});
+    CHECK(std::ranges::equal(dict.values(), std::vector{10, 2, 3}));
+    CHECK(dict.items()[1].key == "two");
+}
+
+TEST_CASE("Freezing a dictionary") {
+    Dict<int, int> dict;
+    for (int i = 0; i < 10000; ++i) {
+        dict[i * 7919] = i;
+    }
+    for (int i = 0; i < 10000; i += 3) {
+        dict.del(i * 7919);
+    }
+
+    const FrozenDict<int, int> frozen(dict);
+    REQUIRE(frozen.size() == dict.size());
+    CHECK(std::ranges::equal(frozen.keys(), dict.keys()));
+    for (int i = 0; i < 10000; ++i) {
+        if (i % 3 == 0) {
+            CHECK_FALSE(frozen.contains(i * 7919));
+        } else {
+            CHECK(frozen.at(i * 7919) == i);
+        }
+        CHECK_FALSE(frozen.contains(i * 7919 + 1));
+    }
+
+    const auto thawed = frozen.to_dict();
+    CHECK(std::ranges::equal(thawed.keys(), dict.keys()));
+    CHECK(std::ranges::equal(thawed.values(), dict.values()));
+}
+
+TEST_CASE("Frozen boolean values") {
+    Dict<int, bool> dict;
+    for (int i = 0; i < 200; ++i) {
+        dict[i] = i % 2 == 0;
+    }
+
+    const FrozenDict<int, bool> frozen(dict);
+    CHECK(frozen.at(10));
+    CHECK_FALSE(frozen[11]);
+    CHECK(std::ranges::count(frozen.values(), true) == 100);
+    CHECK(frozen.to_dict().count() == 100);
+}
+
+TEST_CASE("Frozen dictionary sizes") {
+    const FrozenDict<int, int> empty;
+    CHECK(empty.empty());
+    CHECK_FALSE(empty.contains(0));
+    CHECK(empty.begin() == empty.end());
+
+    for (const size_t size: {1, 2, 3, 5, 17, 100, 1000, 100000}) {
+        std::vector<dictcpp::Item<std::string, size_t>> items;
+        for (size_t i = 0; i < size; ++i) {
+            items.push_back({"key " + std::to_string(i), i});
+        }
+        const FrozenDict<std::string, size_t> dict(items);
+        REQUIRE(dict.size() == size);
+        size_t found = 0;
+        for (size_t i = 0; i < 2 * size; ++i) {
+            const auto key = "key " + std::to_string(i);
+            found += i < size ? dict.at(key) == i : !dict.contains(key);
+        }
+        CHECK(found == 2 * size);
+    }
+}
+
+namespace {
+// Hash giving equal hashes for some different keys
+struct ModuloHash {
+    size_t operator()(const int key) const {
+        return static_cast<size_t>(key % 100);
+    }
+};
+}
+
+TEST_CASE("Keys with equal hashes can be frozen") {
+    Dict<int, int, ModuloHash> dict;
+    for (int i = 0; i < 1000; ++i) {
+        dict[i] = -i;
+    }
+    const FrozenDict<int, int, ModuloHash> frozen(dict);
+    CHECK(frozen.size() == 1000);
+    CHECK(std::ranges::equal(frozen.keys(), dict.keys()));
+    for (int i = 0; i < 1000; ++i) {
+        CHECK(frozen.at(i) == -i);
+        CHECK(frozen.find(i)->key == i);
+    }
+    CHECK_FALSE(frozen.contains(1000));
+    CHECK_FALSE(frozen.contains(-100));
+
+    // A few colliding keys among many distinct ones
+    const FrozenDict<int, int, ModuloHash> small({{1, 1}, {101, 2}, {2, 3}, {201, 4}});
+    CHECK(small.at(1) == 1);
+    CHECK(small.at(101) == 2);
+    CHECK(small.at(201) == 4);
+    CHECK_FALSE(small.contains(301));
+}
+
+TEST_CASE("Concurrent reads of a frozen dictionary") {
+    std::vector<dictcpp::Item<int, int>> items;
+    for (int i = 0; i < 100000; ++i) {
+        items.push_back({i, -i});
+    }
+    const FrozenDict<int, int> dict(items);
+
+    std::vector<std::thread> threads;
+    std::vector<int> found(4);
+    for (size_t t = 0; t < found.size(); ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 100000; ++i) {
+                found[t] += dict.at(i) == -i;
+            }
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    CHECK(std::ranges::count(found, 100000) == 4);
+}
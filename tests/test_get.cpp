@@ -159,3 +159,151 @@ TEST_CASE("Set default") {
     CHECK(dict.at('a') == 11);
 
 }
+
+TEST_CASE("Find") {
+    auto dict = Dict<char, int>{
+        {'a', 1},
+        {'b', 2}
+    };
+
+    const auto it = dict.find('b');
+    REQUIRE(it != dict.items().end());
+    CHECK(it->key == 'b');
+    CHECK(it->value == 2);
+
+    it->value = 20;
+    CHECK(dict.at('b') == 20);
+
+    CHECK(dict.find('c') == dict.items().end());
+
+    const auto &const_dict = dict;
+    const auto const_it = const_dict.find('a');
+    REQUIRE(const_it != const_dict.items().end());
+    CHECK((*const_it).value == 1);
+    CHECK(const_dict.find('z') == const_dict.items().end());
+}
+
+TEST_CASE("Try emplace") {
+    auto dict = Dict<int, std::string>();
+
+    const auto [it1, inserted1] = dict.try_emplace(1, 3, 'x');
+    CHECK(inserted1);
+    CHECK(it1->value == "xxx");
+
+    const auto [it2, inserted2] = dict.try_emplace(1, "unused");
+    CHECK_FALSE(inserted2);
+    CHECK(it2->value == "xxx");
+    REQUIRE(dict.size() == 1);
+
+    const auto [it3, inserted3] = dict.emplace(2, "two");
+    CHECK(inserted3);
+    CHECK(it3->key == 2);
+    CHECK(dict.at(2) == "two");
+
+    CHECK_FALSE(dict.emplace(2, "three").second);
+    CHECK(dict.at(2) == "two");
+
+    // Values may refer to other values of the dictionary, even when the table grows
+    for (int key = 3; key < 100; ++key) {
+        dict.try_emplace(key, dict.at(key - 1));
+    }
+    REQUIRE(dict.size() == 99);
+    CHECK(dict.at(99) == "two");
+}
+
+TEST_CASE("Insert or assign") {
+    auto dict = Dict<char, int>{
+        {'a', 1}
+    };
+
+    const auto [it1, inserted1] = dict.insert_or_assign('a', 10);
+    CHECK_FALSE(inserted1);
+    CHECK(it1->value == 10);
+
+    const auto [it2, inserted2] = dict.insert_or_assign('b', 20);
+    CHECK(inserted2);
+    CHECK(it2->key == 'b');
+
+    REQUIRE(dict.size() == 2);
+    CHECK(dict.at('a') == 10);
+    CHECK(dict.at('b') == 20);
+    CHECK(dict.keys()[1] == 'b');
+}
+
+namespace {
+/// Counts the number of `Name`s constructed from a string_view
+struct Name {
+    static inline int count = 0;
+
+    std::string value;
+
+    explicit Name(const std::string_view value): value(value) {
+        count++;
+    }
+
+    bool operator==(const Name &other) const = default;
+
+    bool operator==(const std::string_view other) const {
+        return value == other;
+    }
+};
+
+struct NameHash {
+    using is_transparent = void;
+
+    size_t operator()(const std::string_view value) const {
+        return std::hash<std::string_view>{}(value);
+    }
+
+    size_t operator()(const Name &name) const {
+        return operator()(name.value);
+    }
+};
+
+template<typename DictType, typename K>
+concept can_look_up = requires(const DictType &dict, const K &key) { dict.contains(key); };
+}
+
+TEST_CASE("Heterogeneous lookup") {
+    auto dict = Dict<std::string, int>{
+        {"one", 1},
+        {"two", 2}
+    };
+
+    const std::string_view one = "one";
+    CHECK(dict.contains(one));
+    CHECK(dict.contains("two"));
+    CHECK_FALSE(dict.contains(std::string_view("three")));
+    CHECK(dict.at(one) == 1);
+    CHECK(std::as_const(dict)["two"] == 2);
+    CHECK(dict.get("three", 3) == 3);
+    CHECK(dict.find(one)->value == 1);
+
+    dict[std::string_view("three")] = 3;
+    REQUIRE(dict.size() == 3);
+    CHECK(dict.keys()[2] == "three");
+    CHECK(dict.setdefault("four", 4) == 4);
+    CHECK(dict.pop(std::string_view("four")) == 4);
+    dict.del("one");
+    CHECK_FALSE(dict.contains("one"));
+    REQUIRE(dict.size() == 2);
+
+    static_assert(!can_look_up<Dict<int>, std::string_view>);
+}
+
+TEST_CASE("Heterogeneous lookup does not construct keys") {
+    auto dict = Dict<Name, int, NameHash>();
+    dict[Name("a")] = 1;
+    dict[Name("b")] = 2;
+    Name::count = 0;
+
+    CHECK(dict.contains(std::string_view("a")));
+    CHECK_FALSE(dict.contains(std::string_view("c")));
+    CHECK(dict.at(std::string_view("b")) == 2);
+    dict[std::string_view("a")] = 10;
+    CHECK(Name::count == 0);
+
+    dict[std::string_view("c")] = 3;
+    CHECK(Name::count == 1);
+    CHECK(dict.at(Name("a")) == 10);
+}
@@ -0,0 +1,106 @@
+#include "dictcpp.hpp"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using dictcpp::Dict;
+
+TEST_CASE("Construct from standard containers") {
+    const std::map<std::string, int> map{{"b", 2}, {"a", 1}, {"c", 3}};
+    const Dict<std::string, int> from_map(map);
+    CHECK(dictcpp::list(from_map) == std::vector<std::string>{"a", "b", "c"});
+    CHECK(from_map.at("c") == 3);
+
+    const std::unordered_map<int, std::string> unordered{{1, "one"}, {2, "two"}};
+    const Dict<int, std::string> from_unordered(unordered);
+    CHECK(from_unordered.size() == 2);
+    CHECK(from_unordered.at(2) == "two");
+
+    // Pairs of other types, with repeated keys keeping their first position and last value
+    const std::vector<std::pair<std::string_view, long>> pairs{{"x", 1}, {"y", 2}, {"x", 3}};
+    const Dict<std::string, int> from_pairs(pairs);
+    CHECK(dictcpp::list(from_pairs) == std::vector<std::string>{"x", "y"});
+    CHECK(from_pairs.at("x") == 3);
+
+    const std::vector<std::tuple<int, char>> tuples{{1, 'a'}, {2, 'b'}};
+    CHECK(Dict<int, char>(tuples).at(2) == 'b');
+
+    auto squares = std::views::iota(0, 5) | std::views::transform([](const int i) {
+        return std::pair(i, i * i);
+    });
+    const Dict<int, int> from_view(squares);
+    CHECK(std::ranges::equal(from_view.values(), std::vector{0, 1, 4, 9, 16}));
+}
+
+TEST_CASE("Construct from rvalue containers moves the items") {
+    std::map<std::unique_ptr<int>, std::unique_ptr<int>> map;
+    map.emplace(std::make_unique<int>(1), std::make_unique<int>(10));
+    map.emplace(std::make_unique<int>(2), std::make_unique<int>(20));
+    const auto *key = map.begin()->first.get();
+
+    // Nodes are extracted, so that even the keys are moved
+    const Dict<std::unique_ptr<int>, std::unique_ptr<int>> dict(std::move(map));
+    CHECK(map.empty());
+    REQUIRE(dict.size() == 2);
+    CHECK(dict.keys()[0].get() == key);
+    CHECK(*dict.values()[0] == 10);
+
+    std::vector<std::pair<int, std::unique_ptr<int>>> pairs;
+    pairs.emplace_back(1, std::make_unique<int>(5));
+    Dict<int, std::unique_ptr<int>> from_vector(std::move(pairs));
+    CHECK(*from_vector.at(1) == 5);
+
+    std::unordered_map<std::string, std::unique_ptr<int>> unordered;
+    unordered.emplace("a", std::make_unique<int>(1));
+    from_vector.clear();
+    Dict<std::string, std::unique_ptr<int>> updated;
+    updated.update(std::move(unordered));
+    CHECK(unordered.empty());
+    CHECK(*updated.at("a") == 1);
+}
+
+TEST_CASE("Update from standard containers") {
+    Dict<std::string, int> dict{{"a", 1}, {"b", 2}};
+    const std::map<std::string, int> map{{"b", 20}, {"c", 30}};
+    dict.update(map);
+    CHECK(dictcpp::list(dict) == std::vector<std::string>{"a", "b", "c"});
+    CHECK(std::ranges::equal(dict.values(), std::vector{1, 20, 30}));
+
+    dict |= std::unordered_map<std::string, int>{{"d", 40}};
+    dict |= std::vector<std::pair<std::string, int>>{{"a", 10}};
+    CHECK(dict.size() == 4);
+    CHECK(dict.at("a") == 10);
+    CHECK(dict.at("d") == 40);
+
+    // Other dictionaries are ranges of keys, so are still merged by `update(const Dict &)`
+    Dict<std::string, int> other{{"e", 50}};
+    dict.update(other);
+    CHECK(dict.at("e") == 50);
+}
+
+TEST_CASE("Convert to standard containers") {
+    Dict<std::string, int> dict{{"b", 2}, {"a", 1}, {"c", 3}};
+    dict.del("c");
+
+    const auto map = dict.to<std::map>();
+    CHECK(map == std::map<std::string, int>{{"a", 1}, {"b", 2}});
+    const auto unordered = dict.to<std::unordered_map<std::string, long>>();
+    CHECK(unordered == std::unordered_map<std::string, long>{{"a", 1}, {"b", 2}});
+    CHECK(dict.size() == 2);
+
+    Dict<int, std::unique_ptr<int>> owners;
+    owners[1] = std::make_unique<int>(100);
+    const auto moved = std::move(owners).to<std::unordered_map>();
+    CHECK(owners.empty());
+    CHECK(*moved.at(1) == 100);
+}
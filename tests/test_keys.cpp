@@ -0,0 +1,120 @@
+#include "dictcpp.hpp"
+#include "frozen_dict.hpp"
+
+#include "catch.hpp"
+
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using dictcpp::Dict;
+
+namespace {
+template<typename R>
+std::vector<typename std::ranges::range_value_t<R> > to_vector(const R &range) {
+    return {range.begin(), range.end()};
+}
+}
+
+TEST_CASE("Set operations on key views") {
+    const Dict<int, std::string> a{{1, "a"}, {2, "b"}, {3, "c"}, {4, "d"}};
+    const Dict<int, double> b{{6, 0.5}, {4, 0.5}, {2, 0.5}};
+
+    // Only the smaller side is iterated, in its order
+    CHECK(to_vector(a.keys() & b.keys()) == std::vector{4, 2});
+    CHECK(to_vector(b.keys() & a) == std::vector{4, 2});
+    CHECK(to_vector(a.keys() | b.keys()) == std::vector{1, 2, 3, 4, 6});
+    CHECK(to_vector(a.keys() - b.keys()) == std::vector{1, 3});
+    CHECK(to_vector(b.keys() - a.keys()) == std::vector{6});
+    CHECK(to_vector(a.keys() ^ b.keys()) == std::vector{1, 3, 6});
+
+    // Any range of keys, collected into a set
+    const std::vector<int> keys{5, 3, 3, 1};
+    CHECK(to_vector(a.keys() & keys) == std::vector{3, 1});
+    CHECK(to_vector(a.keys() | keys) == std::vector{1, 2, 3, 4, 5});
+    CHECK(to_vector(a.keys() - std::set{1, 2}) == std::vector{3, 4});
+    CHECK(to_vector(a.keys() ^ std::vector{4, 5}) == std::vector{1, 2, 3, 5});
+
+    // The results are lazy views of the live dictionaries
+    Dict<int, int> c{{1, 1}, {2, 2}};
+    auto common = c.keys() & a.keys();
+    c[3] = 3;
+    c.del(1);
+    CHECK(to_vector(common) == std::vector{2, 3});
+    CHECK(std::ranges::distance(a.keys() & Dict<int, int>{}) == 0);
+}
+
+TEST_CASE("Comparing key views as sets") {
+    const Dict<std::string, int> a{{"x", 1}, {"y", 2}};
+    const Dict<std::string, int> b{{"y", 3}, {"x", 4}};
+    const Dict<std::string, bool> c{{"x", true}, {"y", false}, {"z", true}};
+    const Dict<std::string, int> d{{"w", 0}};
+
+    CHECK(a.keys() == b.keys());
+    CHECK(a.keys() <= b.keys());
+    CHECK(a.keys() < c.keys());
+    CHECK(c.keys() > a.keys());
+    CHECK_FALSE(a.keys() < b.keys());
+    CHECK_FALSE(a.keys() <= d.keys());
+    CHECK_FALSE(a.keys() >= d.keys());
+    CHECK(a.keys() != d.keys());
+
+    CHECK(a.keys().isdisjoint(d.keys()));
+    CHECK_FALSE(a.keys().isdisjoint(c));
+    CHECK(a.keys().isdisjoint(std::vector<std::string>{"v", "w"}));
+    CHECK(a.keys().issubset(c.keys()));
+    CHECK(a.keys().issubset(std::vector<std::string>{"y", "z", "x", "x"}));
+    CHECK_FALSE(c.keys().issubset(std::vector<std::string>{"x", "y"}));
+    CHECK(c.keys().issuperset(std::vector<std::string>{"z", "x", "z"}));
+    CHECK_FALSE(c.keys().issuperset(std::vector<std::string>{"z", "w"}));
+    CHECK(c.keys().contains("z"));
+}
+
+TEST_CASE("Set operations with other types of keys") {
+    const Dict<std::string, int> a{{"x", 1}, {"y", 2}};
+    const std::vector<std::string_view> views{"y", "z", "z"};
+
+    // Keys looked up as string views, and converted to strings when collected
+    CHECK(to_vector(a.keys() & views) == std::vector<std::string>{"y"});
+    CHECK(to_vector(a.keys() | views) == std::vector<std::string>{"x", "y", "z"});
+    CHECK(to_vector(a.keys() ^ views) == std::vector<std::string>{"x", "z"});
+    CHECK_FALSE(a.keys().isdisjoint(views));
+    CHECK(a.keys().issubset(std::vector<std::string_view>{"x", "y", "w"}));
+
+    // Keys only explicitly convertible to those of a dictionary without heterogeneous lookup
+    const Dict<std::string, int, std::hash<std::string> > b{{"x", 1}, {"w", 2}};
+    CHECK(to_vector(b.keys() - views) == std::vector<std::string>{"x", "w"});
+    CHECK(to_vector(b.keys() | views) == std::vector<std::string>{"x", "w", "y", "z"});
+    CHECK(b.keys().issubset(std::vector<std::string_view>{"w", "x"}));
+}
+
+TEST_CASE("Set operations on large key views") {
+    Dict<int, int> evens;
+    Dict<int, int> thirds;
+    for (int i = 0; i < 100000; ++i) {
+        evens[2 * i] = i;
+        thirds[3 * i] = i;
+    }
+    for (int i = 0; i < 300000; i += 12) {
+        thirds.del(i);
+    }
+
+    // Multiples of 6, but not of 12
+    const auto common = to_vector(evens.keys() & thirds.keys());
+    CHECK(common.size() == 16667);
+    CHECK(std::ranges::all_of(common, [](const int key) { return key % 6 == 0 && key % 12 != 0; }));
+    CHECK(std::ranges::distance(evens.keys() | thirds.keys()) == 100000 + 75000 - 16667);
+    CHECK(std::ranges::distance(evens.keys() ^ thirds.keys()) == 100000 + 75000 - 2 * 16667);
+    CHECK(std::ranges::is_sorted(to_vector(evens.keys() - thirds.keys())));
+}
+
+TEST_CASE("Set operations on frozen key views") {
+    const dictcpp::FrozenDict<int, int> frozen({{1, 1}, {2, 2}, {3, 3}});
+    const Dict<int, int> dict{{3, 0}, {4, 0}};
+
+    CHECK(to_vector(frozen.keys() & dict.keys()) == std::vector{3});
+    CHECK(to_vector(frozen.keys() - std::vector{1}) == std::vector{2, 3});
+    CHECK(frozen.keys().issuperset(std::vector{1, 2}));
+    CHECK(dict.keys() <=> frozen.keys() == std::partial_ordering::unordered);
+}
@@ -0,0 +1,103 @@
+#include "dict_loader.hpp"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using dictcpp::Dict;
+using dictcpp::LoadOptions;
+
+TEST_CASE("Loading key=value lines") {
+    std::istringstream in("# settings\nname = dictcpp\n\nversion=3\r\nname=DictCPP\nempty=\n");
+    Dict<std::string, std::string> dict;
+    CHECK(dictcpp::load_key_values(in, dict) == 4);
+    CHECK(dictcpp::list(dict) == std::vector<std::string>{"name", "version", "empty"});
+    CHECK(dict["name"] == "DictCPP");
+    CHECK(dict["version"] == "3");
+    CHECK(dict["empty"].empty());
+
+    std::istringstream invalid("a=1\nb\n");
+    Dict<std::string, int> numbers;
+    CHECK_THROWS_AS(dictcpp::load_key_values(invalid, numbers), std::runtime_error);
+    std::istringstream not_a_number("a=x\n");
+    CHECK_THROWS_AS(dictcpp::load_key_values(not_a_number, numbers), std::runtime_error);
+}
+
+TEST_CASE("Loading in parallel keeps the first-seen order") {
+    std::string text;
+    for (int i = 0; i < 20000; ++i) {
+        text += std::to_string(i % 15000) + "=" + std::to_string(i) + "\n";
+    }
+
+    for (const size_t threads: {1, 4}) {
+        std::istringstream in(text);
+        Dict<int, int> dict;
+        // Small chunks, so that records span their boundaries
+        CHECK(dictcpp::load_key_values(in, dict, {.chunk_size = 1000, .threads = threads, .expected_size = 15000}) == 20000);
+        REQUIRE(dict.size() == 15000);
+        for (int i = 0; i < 15000; ++i) {
+            CHECK(dict.keys()[static_cast<size_t>(i)] == i);
+        }
+        CHECK(dict[0] == 15000);
+        CHECK(dict[14999] == 14999);
+    }
+}
+
+TEST_CASE("Loading CSV") {
+    std::istringstream in("key,value\nplain,1\n\"quoted, with comma\",2\r\n\"multi\nline \"\"quote\"\"\",3\nlast,4");
+    Dict<std::string, int> dict;
+    CHECK(dictcpp::load_csv(in, dict, {.chunk_size = 8, .threads = 2, .header = true}) == 4);
+    CHECK(dictcpp::list(dict) == std::vector<std::string>{"plain", "quoted, with comma", "multi\nline \"quote\"", "last"});
+    CHECK(std::ranges::equal(dict.values(), std::vector{1, 2, 3, 4}));
+
+    std::istringstream tabs("a\ttrue\nb\t0\n");
+    Dict<std::string, bool> flags;
+    CHECK(dictcpp::load_csv(tabs, flags, {.delimiter = '\t'}) == 2);
+    CHECK(flags["a"]);
+    CHECK_FALSE(flags["b"]);
+
+    // A quote inside an unquoted field is a character, and does not hide the ends of records
+    CHECK(dictcpp::detail::csv_end("a\"b,1\nc,\"x", ',') == 6);
+    CHECK(dictcpp::detail::csv_end("\"a\"\"\n\",1\nb", ',') == 9);
+    std::istringstream stray("a\"b,1\nc,2\n");
+    Dict<std::string, int> strays;
+    CHECK(dictcpp::load_csv(stray, strays, {.chunk_size = 4}) == 2);
+    CHECK(strays["a\"b"] == 1);
+
+    std::istringstream three_columns("a,1,2\n");
+    CHECK_THROWS_AS(dictcpp::load_csv(three_columns, dict), std::runtime_error);
+    std::istringstream one_column("a\n");
+    CHECK_THROWS_AS(dictcpp::load_csv(one_column, dict), std::runtime_error);
+}
+
+TEST_CASE("Loading JSON") {
+    std::istringstream in(R"( {"a": "x\tyé😀", "b" : 2.5, "c": [1, {"d": "]"}], "d": null,
+                              "a": "last"} )");
+    Dict<std::string, std::string> dict;
+    CHECK(dictcpp::load_json(in, dict, {.chunk_size = 4}) == 5);
+    CHECK(dictcpp::list(dict) == std::vector<std::string>{"a", "b", "c", "d"});
+    CHECK(dict["a"] == "last");
+    CHECK(dict["b"] == "2.5");
+    CHECK(dict["c"] == R"([1, {"d": "]"}])");
+    CHECK(dict["d"] == "null");
+
+    std::istringstream escapes(R"({"\"k\"": "é😀\\"})");
+    CHECK(dictcpp::load_json(escapes, dict) == 1);
+    CHECK(dict["\"k\""] == "\xc3\xa9\xf0\x9f\x98\x80\\");
+
+    std::istringstream numbers(R"({"1": 10, "2": -20})");
+    Dict<int, long> typed;
+    CHECK(dictcpp::load_json(numbers, typed) == 2);
+    CHECK(typed[2] == -20);
+
+    std::istringstream empty("{}");
+    CHECK(dictcpp::load_json(empty, typed) == 0);
+    for (const auto *text: {"[]", R"({"a": 1)", R"({"a" 1})", R"({"a": 1} x)", R"({"a": 1,})",
+                             R"({"\x": 1})", R"({"a": "\q"})", R"({"\uDC00": 1})", R"({"a": "x\uDFFFy"})"}) {
+        std::istringstream invalid(text);
+        CHECK_THROWS_AS(dictcpp::load_json(invalid, dict), std::runtime_error);
+    }
+}
@@ -0,0 +1,184 @@
+#include "lru_dict.hpp"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using dictcpp::Dict;
+using dictcpp::LruDict;
+
+TEST_CASE("Move to end") {
+    Dict<std::string, int> dict{{"a", 1}, {"b", 2}, {"c", 3}};
+    dict.move_to_end("a");
+    CHECK(dictcpp::list(dict) == std::vector<std::string>{"b", "c", "a"});
+    dict.move_to_end("c", false);
+    CHECK(dictcpp::list(dict) == std::vector<std::string>{"c", "b", "a"});
+    dict.move_to_end("a");
+    CHECK(dictcpp::list(dict) == std::vector<std::string>{"c", "b", "a"});
+    CHECK_THROWS_AS(dict.move_to_end("d"), std::out_of_range);
+    CHECK(dict.at("c") == 3);
+
+    // Large dictionaries, with tombstones and compaction
+    Dict<int, int> large;
+    for (int i = 0; i < 1000; ++i) {
+        large[i] = i;
+    }
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 1000; i += 2) {
+            large.move_to_end(i);
+        }
+    }
+    REQUIRE(large.size() == 1000);
+    for (int i = 0; i < 500; ++i) {
+        CHECK(large.keys()[static_cast<size_t>(i)] == 2 * i + 1);
+        CHECK(large.keys()[static_cast<size_t>(i + 500)] == 2 * i);
+        CHECK(large.at(i) == i);
+    }
+
+    large.move_to_end(999, false);
+    large.move_to_end(998, false);
+    CHECK(large.keys().front() == 998);
+    CHECK(large.keys()[1] == 999);
+    CHECK(large.keys().back() == 998 - 2);
+    CHECK(large.at(999) == 999);
+}
+
+TEST_CASE("Pop the first item") {
+    Dict<int, int> dict;
+    for (int i = 0; i < 100; ++i) {
+        dict[i] = -i;
+    }
+    for (int i = 0; i < 50; ++i) {
+        const auto [key, value] = dict.popitem(false);
+        CHECK(key == i);
+        CHECK(value == -i);
+    }
+    CHECK(dict.size() == 50);
+    CHECK(dict.keys().front() == 50);
+
+    // Moving to the front reuses the entries before the first
+    dict.move_to_end(99, false);
+    CHECK(dict.keys().front() == 99);
+    CHECK(dict.popitem().key == 98);
+    CHECK(dict.popitem(false).key == 99);
+
+    Dict<int, int> small{{1, 1}, {2, 2}};
+    CHECK(small.popitem(false).key == 1);
+    CHECK(small.popitem(false).key == 2);
+    CHECK_THROWS_AS(small.popitem(false), std::out_of_range);
+}
+
+TEST_CASE("Reverse iteration") {
+    Dict<int, int> dict;
+    for (int i = 0; i < 100; ++i) {
+        dict[i] = i * i;
+    }
+    for (int i = 0; i < 100; i += 3) {
+        dict.del(i);
+    }
+
+    std::vector<int> keys(dict.rbegin(), dict.rend());
+    CHECK(keys.front() == 98);
+    CHECK(keys.back() == 1);
+    CHECK(std::ranges::equal(keys | std::views::reverse, dict.keys()));
+    CHECK(std::ranges::equal(dict.values() | std::views::reverse | std::views::take(2), std::vector{98 * 98, 97 * 97}));
+    for (const auto &[key, value]: dict.items() | std::views::reverse) {
+        CHECK(value == key * key);
+    }
+}
+
+TEST_CASE("LRU dictionary") {
+    std::vector<std::string> evicted;
+    LruDict<std::string, int> cache(3, [&](std::string key, int) {
+        evicted.push_back(std::move(key));
+    });
+    CHECK_THROWS_AS((LruDict<int, int>(0)), std::invalid_argument);
+
+    cache.insert_or_assign("a", 1);
+    cache.insert_or_assign("b", 2);
+    cache["c"] = 3;
+    CHECK(cache.get("a") == 1);
+    CHECK(cache.insert_or_assign("d", 4).second);
+    CHECK(evicted == std::vector<std::string>{"b"});
+    CHECK(dictcpp::len(cache) == 3);
+
+    // Looking up without using an item does not change the order
+    CHECK(cache.contains("c"));
+    CHECK_FALSE(cache.contains("b"));
+    CHECK(std::ranges::equal(cache.keys(), std::vector<std::string>{"c", "a", "d"}));
+
+    CHECK((*cache.find("c")).value == 3);
+    CHECK(cache.find("b") == cache.items().end());
+    cache.at("a") += 10;
+    CHECK_THROWS_AS(cache.at("b"), std::out_of_range);
+    CHECK(cache.get("b", -1) == -1);
+    CHECK_FALSE(cache.insert_or_assign("d", 40).second);
+    CHECK(std::ranges::equal(cache.keys(), std::vector<std::string>{"c", "a", "d"}));
+    CHECK(std::ranges::equal(cache.values(), std::vector{3, 11, 40}));
+
+    cache["e"] = 5;
+    CHECK(evicted == std::vector<std::string>{"b", "c"});
+    CHECK(cache.pop("a") == 11);
+    cache.set_capacity(1);
+    CHECK(evicted == std::vector<std::string>{"b", "c", "d"});
+    CHECK(std::ranges::equal(cache.keys(), std::vector<std::string>{"e"}));
+    cache.clear();
+    CHECK(cache.empty());
+}
+
+namespace {
+template<typename D, typename K>
+concept CanLookUp = requires(D &dict, const K &key) {
+    dict.contains(key);
+    dict.find(key);
+    dict.at(key);
+    dict.get(key);
+    dict.pop(key);
+    dict.del(key);
+};
+}
+
+TEST_CASE("Heterogeneous lookups in an LRU dictionary") {
+    LruDict<std::string, int> cache(2);
+    cache["a"] = 1;
+    cache["b"] = 2;
+    CHECK(cache.get(std::string_view("a")) == 1);
+    CHECK(cache.contains(std::string_view("b")));
+    CHECK(std::ranges::equal(cache.keys(), std::vector<std::string>{"b", "a"}));
+    CHECK(cache.pop(std::string_view("b")) == 2);
+
+    // Without a transparent hash, keys are converted to `Key` at the call, and other types of
+    // keys are rejected there
+    using Plain = LruDict<std::string, int, std::hash<std::string> >;
+    Plain plain(2);
+    plain["a"] = 1;
+    CHECK(plain.at("a") == 1);
+    CHECK(plain.find("a") != plain.items().end());
+    static_assert(CanLookUp<LruDict<std::string, int>, std::string_view>);
+    static_assert(!CanLookUp<Plain, std::string_view>);
+}
+
+TEST_CASE("LRU dictionary under load") {
+    LruDict<int, int> cache(100);
+    size_t hits = 0;
+    for (int i = 0; i < 100000; ++i) {
+        // The even keys 0-48 are used often, so are never evicted
+        const int key = i % 2 == 0 ? i % 50 : 50 + i;
+        // Finding an item moves it, invalidating iterators, so `end()` is taken afterwards
+        const auto it = cache.find(key);
+        if (it != cache.items().end()) {
+            hits++;
+        } else {
+            cache[key] = key;
+        }
+    }
+    CHECK(hits == 50000 - 25);
+    CHECK(cache.size() == 100);
+    for (int key = 0; key < 50; key += 2) {
+        CHECK(cache.at(key) == key);
+    }
+}
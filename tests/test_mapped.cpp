@@ -0,0 +1,204 @@
+#include "mapped_dict.hpp"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using dictcpp::Dict;
+using dictcpp::MappedDict;
+
+namespace {
+// A file in the temporary directory, removed at the end of the test
+struct TemporaryFile {
+    std::filesystem::path path;
+
+    explicit TemporaryFile(const std::string &name): path(std::filesystem::temp_directory_path() / name) {
+    }
+
+    ~TemporaryFile() {
+        std::filesystem::remove(path);
+    }
+};
+
+template<typename Key, typename Value>
+void write_file(const std::filesystem::path &path, const Dict<Key, Value> &dict) {
+    std::ofstream out(path, std::ios::binary);
+    dictcpp::write_mapped(out, dict);
+}
+
+struct Point {
+    int x;
+    int y;
+
+    bool operator==(const Point &other) const = default;
+};
+
+struct Name {
+    std::string first;
+    std::string last;
+};
+}
+
+template<>
+struct std::hash<Point> {
+    size_t operator()(const Point &point) const noexcept {
+        return std::hash<int>{}(point.x) * 31 + std::hash<int>{}(point.y);
+    }
+};
+
+template<>
+struct dictcpp::Serializer<Name> {
+    static void write(std::ostream &out, const Name &name) {
+        Serializer<std::string>::write(out, name.first);
+        Serializer<std::string>::write(out, name.last);
+    }
+
+    static Name read(std::istream &in) {
+        auto first = Serializer<std::string>::read(in);
+        return {std::move(first), Serializer<std::string>::read(in)};
+    }
+};
+
+TEST_CASE("Mapped dictionary with string keys") {
+    Dict<std::string, std::string> dict{{"alpha", "a"}, {"beta", ""}, {"gamma", "g"}};
+    for (int i = 0; i < 1000; ++i) {
+        dict["key " + std::to_string(i)] = std::string(static_cast<size_t>(i % 50), 'x');
+    }
+    dict.del("beta");
+
+    const TemporaryFile file("dictcpp_test_strings.dict");
+    write_file(file.path, dict);
+    const MappedDict<std::string, std::string> mapped(file.path);
+
+    REQUIRE(mapped.size() == dict.size());
+    CHECK(mapped.at("alpha") == "a");
+    CHECK(mapped["key 49"] == std::string(49, 'x'));
+    CHECK(mapped.at(std::string("key 50")).empty());
+    CHECK_FALSE(mapped.contains("beta"));
+    CHECK_THROWS_AS(mapped.at("beta"), std::out_of_range);
+    CHECK(mapped.get("beta", "none") == "none");
+    for (const auto &[key, value]: dict.items()) {
+        CHECK(mapped.at(key) == value);
+    }
+
+    CHECK(std::ranges::equal(mapped.keys(), dict.keys()));
+    CHECK(std::ranges::equal(mapped.values(), dict.values()));
+    const auto copy = mapped.to_dict();
+    CHECK(std::ranges::equal(copy.keys(), dict.keys()));
+}
+
+TEST_CASE("Mapped dictionary with fixed-size keys and values") {
+    Dict<Point, double> dict;
+    for (int i = 0; i < 10000; ++i) {
+        dict[{i, -i}] = i * 0.5;
+    }
+
+    std::stringstream stream;
+    dictcpp::write_mapped(stream, dict);
+    const auto buffer = stream.str();
+
+    // Any dictionary in memory can be used in place, not only mapped files
+    const MappedDict<Point, double> mapped(std::as_bytes(std::span(buffer)));
+    REQUIRE(mapped.size() == 10000);
+    for (int i = 0; i < 10000; ++i) {
+        CHECK(mapped.at({i, -i}) == i * 0.5);
+        CHECK_FALSE(mapped.contains({i, i + 1}));
+    }
+    CHECK(mapped.key(3) == Point{3, -3});
+
+    std::stringstream empty_stream;
+    dictcpp::write_mapped(empty_stream, Dict<int, int>());
+    const auto empty_buffer = empty_stream.str();
+    const MappedDict<int, int> empty(std::as_bytes(std::span(empty_buffer)));
+    CHECK(empty.empty());
+    CHECK_FALSE(empty.contains(0));
+}
+
+TEST_CASE("Mapped dictionary validation") {
+    std::stringstream stream;
+    dictcpp::write_mapped(stream, Dict<int, int>{{1, 2}});
+    auto data = stream.str();
+    const auto bytes = [&] {
+        return std::as_bytes(std::span(data));
+    };
+
+    CHECK(MappedDict<int, int>(bytes()).at(1) == 2);
+    CHECK_THROWS_AS((MappedDict<int, long long>(bytes())), std::runtime_error);
+    CHECK_THROWS_AS((MappedDict<std::string, int>(bytes())), std::runtime_error);
+    CHECK_THROWS_AS((MappedDict<int, int>(bytes().first(100))), std::runtime_error);
+
+    data[0] = 'X';
+    CHECK_THROWS_AS((MappedDict<int, int>(bytes())), std::runtime_error);
+    CHECK_THROWS_AS((MappedDict<int, int>(std::filesystem::path("/nonexistent/dictcpp.dict"))), std::runtime_error);
+}
+
+TEST_CASE("Corrupt mapped dictionaries") {
+    std::stringstream stream;
+    dictcpp::write_mapped(stream, Dict<int, int>{{1, 2}, {3, 4}});
+    const auto original = stream.str();
+    dictcpp::detail::MappedHeader header{};
+    std::memcpy(&header, original.data(), sizeof(header));
+    const auto fill_index = [&](std::string &data, const uint64_t entry) {
+        for (uint64_t slot = 0; slot < header.table_size; ++slot) {
+            std::memcpy(data.data() + header.index_offset + slot * sizeof(entry), &entry, sizeof(entry));
+        }
+    };
+
+    // An index entry past the last item
+    auto data = original;
+    const uint64_t check = dictcpp::detail::mix(dictcpp::detail::stable_hash(1)) >> 32;
+    fill_index(data, check << 32 | 3);
+    const MappedDict<int, int> past_end(std::as_bytes(std::span(data)));
+    CHECK_THROWS_AS(past_end.at(1), std::runtime_error);
+
+    // An index without any empty slot, which would never end a probe
+    auto full = original;
+    fill_index(full, ~uint64_t{0} << 32 | 1);
+    const MappedDict<int, int> no_empty_slot(std::as_bytes(std::span(full)));
+    CHECK_THROWS_AS(no_empty_slot.contains(5), std::runtime_error);
+
+    // A string offset past the end of the characters
+    std::stringstream string_stream;
+    dictcpp::write_mapped(string_stream, Dict<std::string, std::string>{{"a", "xy"}, {"b", "z"}});
+    auto strings = string_stream.str();
+    std::memcpy(&header, strings.data(), sizeof(header));
+    const uint64_t offset = 1000;
+    std::memcpy(strings.data() + header.value_offset + sizeof(offset), &offset, sizeof(offset));
+    const MappedDict<std::string, std::string> bad_offset(std::as_bytes(std::span(strings)));
+    CHECK(bad_offset.key(1) == "b");
+    CHECK_THROWS_AS(bad_offset.at("a"), std::runtime_error);
+    CHECK_THROWS_AS(bad_offset.value(1), std::runtime_error);
+
+    // Lengths past the end of the file are found when it is opened
+    const auto length = ~uint64_t{0} - 8;
+    std::memcpy(strings.data() + header.value_offset + 2 * sizeof(length), &length, sizeof(length));
+    CHECK_THROWS_AS((MappedDict<std::string, std::string>(std::as_bytes(std::span(strings)))), std::runtime_error);
+}
+
+TEST_CASE("Streaming binary format") {
+    Dict<std::string, Name> dict;
+    for (int i = 0; i < 1000; ++i) {
+        dict["id" + std::to_string(i)] = {"first " + std::to_string(i), std::string(static_cast<size_t>(i), 'z')};
+    }
+
+    std::stringstream stream;
+    dictcpp::write_binary(stream, dict);
+    const auto copy = dictcpp::read_binary<Dict<std::string, Name>>(stream);
+    REQUIRE(copy.size() == 1000);
+    CHECK(std::ranges::equal(copy.keys(), dict.keys()));
+    CHECK(copy.at("id999").first == "first 999");
+    CHECK(copy.at("id999").last.size() == 999);
+
+    auto truncated = std::stringstream(stream.str().substr(0, stream.str().size() / 2));
+    CHECK_THROWS_AS((dictcpp::read_binary<Dict<std::string, Name>>(truncated)), std::runtime_error);
+    auto garbage = std::stringstream("not a dictionary");
+    CHECK_THROWS_AS((dictcpp::read_binary<Dict<int, int>>(garbage)), std::runtime_error);
+}
@@ -2,8 +2,20 @@
 
 #include "dictcpp.hpp"
 
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
 using dictcpp::Dict;
 
+namespace {
+template<typename DictType>
+bool same_items(const DictType &a, const DictType &b) {
+    return std::ranges::equal(a.keys(), b.keys()) && std::ranges::equal(a.values(), b.values());
+}
+}
+
 TEST_CASE("Update dictionary") {
     auto dict1 = Dict<int, char>{
         {1, 'a'},
@@ -158,3 +170,59 @@ TEST_CASE("Update dictionary with |= vector") {
     CHECK(dict1.at(32) == 'h');
     CHECK(dict1.at(64) == 'i');
 }
+
+TEST_CASE("Merge many dictionaries") {
+    std::vector<Dict<std::string, int> > parts(20);
+    for (int i = 0; i < 20000; ++i) {
+        parts[static_cast<size_t>(i % 20)]["word " + std::to_string(i * 13 % 3000)] += 1;
+    }
+    const auto deleted = parts[4].keys().front();
+    parts[4].del(deleted);
+
+    Dict<std::string, int> expected;
+    Dict<std::string, int> counts;
+    for (const auto &part: parts) {
+        expected |= part;
+        for (const auto &[word, n]: part.items()) {
+            counts[word] += n;
+        }
+    }
+
+    const auto merged = dictcpp::merge(parts);
+    CHECK(same_items(merged, expected));
+    CHECK(merged.capacity() < 2 * merged.size());
+
+    const auto summed = dictcpp::merge(parts, std::plus<>());
+    CHECK(same_items(summed, counts));
+    CHECK(same_items(dictcpp::merge(parts, std::plus<>(), dictcpp::Parallel{4}), counts));
+
+    // Moving the dictionaries leaves them empty
+    const auto moved = dictcpp::merge(std::move(parts), dictcpp::Parallel{3});
+    CHECK(same_items(moved, expected));
+    CHECK(std::ranges::all_of(parts, [](const auto &part) { return part.empty(); }));
+
+    CHECK(dictcpp::merge(std::vector<Dict<int, int> >()).empty());
+    CHECK(dictcpp::merge(std::vector<Dict<int, int> >{{{1, 2}}, {{1, 3}, {2, 4}}}).at(1) == 3);
+}
+
+TEST_CASE("Merge large dictionaries on several threads") {
+    std::vector<Dict<int, bool> > parts(8);
+    for (int i = 0; i < 400000; ++i) {
+        parts[static_cast<size_t>(i % 8)][i % 150000] = i % 3 == 0;
+    }
+
+    Dict<int, bool> expected;
+    Dict<int, bool> any;
+    for (const auto &part: parts) {
+        expected.update(part);
+        for (const auto &[key, flag]: part.items()) {
+            any[key] = any.get(key, false) || flag;
+        }
+    }
+
+    for (const size_t threads: {1, 2, 8}) {
+        CHECK(same_items(dictcpp::merge(parts, dictcpp::Parallel{threads}), expected));
+        const auto merged = dictcpp::merge(parts, std::logical_or<>(), dictcpp::Parallel{threads});
+        CHECK(same_items(merged, any));
+    }
+}
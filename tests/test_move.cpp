@@ -0,0 +1,131 @@
+#include "dictcpp.hpp"
+
+#include "catch.hpp"
+
+#include <memory>
+#include <string>
+
+using dictcpp::Dict;
+using dictcpp::Item;
+
+TEST_CASE("Move-only values") {
+    auto dict = Dict<int, std::unique_ptr<int>>();
+
+    dict[1] = std::make_unique<int>(10);
+    dict.try_emplace(2, std::make_unique<int>(20));
+    dict.insert_or_assign(3, std::make_unique<int>(30));
+    dict.emplace(4, std::make_unique<int>(40));
+    REQUIRE(dict.size() == 4);
+    CHECK(*dict.at(1) == 10);
+    CHECK(*dict.at(4) == 40);
+
+    const auto value = dict.pop(2);
+    REQUIRE(value);
+    CHECK(*value == 20);
+    CHECK_FALSE(dict.contains(2));
+    CHECK(dict.pop(2, std::make_unique<int>(0)) != nullptr);
+
+    const auto [key, last] = dict.popitem();
+    CHECK(key == 4);
+    CHECK(*last == 40);
+
+    CHECK(*dict.setdefault(5, std::make_unique<int>(50)) == 50);
+    CHECK(*dict.setdefault(5, std::make_unique<int>(0)) == 50);
+    CHECK(dict.setdefault(6) == nullptr);
+
+    dict.del(6);
+    dict.compact();
+    REQUIRE(dict.size() == 3);
+    CHECK(dict.keys()[2] == 5);
+
+    auto moved = std::move(dict);
+    CHECK(dict.empty());
+    CHECK_FALSE(dict.contains(1));
+    REQUIRE(moved.size() == 3);
+    CHECK(*moved.at(3) == 30);
+
+    dict[7] = std::make_unique<int>(70);
+    CHECK(dict.size() == 1);
+}
+
+TEST_CASE("Move constructor from vector") {
+    auto items = std::vector<Item<std::string>>{
+        {"a", std::string(100, 'a')},
+        {"b", std::string(100, 'b')},
+        {"a", std::string(100, 'c')}
+    };
+    const auto *data = items[1].value.data();
+
+    const auto dict = Dict(std::move(items));
+    REQUIRE(dict.size() == 2);
+    CHECK(dict.at("a") == std::string(100, 'c'));
+    CHECK(dict.at("b").data() == data);
+}
+
+TEST_CASE("Move update and merge") {
+    auto dict1 = Dict<int, std::unique_ptr<int>>();
+    dict1[1] = std::make_unique<int>(1);
+    dict1[2] = std::make_unique<int>(2);
+
+    auto dict2 = Dict<int, std::unique_ptr<int>>();
+    dict2[2] = std::make_unique<int>(20);
+    dict2[3] = std::make_unique<int>(30);
+    const auto *pointer = dict2.at(3).get();
+
+    dict1.update(std::move(dict2));
+    CHECK(dict2.empty());
+    REQUIRE(dict1.size() == 3);
+    CHECK(*dict1.at(2) == 20);
+    CHECK(dict1.at(3).get() == pointer);
+
+    auto dict3 = Dict<int, std::unique_ptr<int>>();
+    dict3[4] = std::make_unique<int>(40);
+
+    auto merged = std::move(dict1) | std::move(dict3);
+    REQUIRE(merged.size() == 4);
+    CHECK(dict3.empty());
+    CHECK(*merged.at(4) == 40);
+    CHECK(merged.at(3).get() == pointer);
+
+    auto dict4 = Dict<int, std::unique_ptr<int>>();
+    dict4[5] = std::make_unique<int>(50);
+    merged |= std::move(dict4);
+    CHECK(merged.size() == 5);
+
+    const auto strings = Dict<int, std::string>{{1, "one"}};
+    const auto merged_strings = Dict<int, std::string>{{2, "two"}} | strings;
+    REQUIRE(merged_strings.size() == 2);
+    CHECK(merged_strings.keys()[0] == 2);
+    CHECK(merged_strings.at(1) == "one");
+}
+
+namespace {
+// Hash with a different seed for each default-constructed instance (copies keep the seed)
+struct SeededHash {
+    static inline size_t next_seed = 1;
+    size_t seed = next_seed++;
+
+    size_t operator()(const int key) const {
+        return std::hash<int>{}(key) ^ seed * 0x9E3779B97F4A7C15;
+    }
+};
+}
+
+TEST_CASE("Moving keeps the hash function") {
+    Dict<int, int, SeededHash> dict;
+    for (int i = 0; i < 100; ++i) {
+        dict[i] = i;
+    }
+
+    Dict<int, int, SeededHash> moved(std::move(dict));
+    CHECK(moved.at(42) == 42);
+    moved[100] = 100;
+
+    Dict<int, int, SeededHash> assigned;
+    assigned[-1] = -1;
+    assigned = std::move(moved);
+    for (int i = 0; i <= 100; ++i) {
+        CHECK(assigned.at(i) == i);
+    }
+    CHECK_FALSE(assigned.contains(-1));
+}
@@ -0,0 +1,149 @@
+#include "dictcpp.hpp"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using dictcpp::Dict;
+using dictcpp::Item;
+using dictcpp::Parallel;
+
+namespace {
+// Items with many repeated keys, in an order where repeats are far apart
+std::vector<Item<std::string, int> > repeated_items(const int count) {
+    std::vector<Item<std::string, int> > items;
+    for (int i = 0; i < count; ++i) {
+        items.push_back({"key " + std::to_string(i * 7919LL % (count / 3)), i});
+    }
+    return items;
+}
+
+template<typename DictType>
+bool same_items(const DictType &a, const DictType &b) {
+    return a.size() == b.size() && std::ranges::equal(a.keys(), b.keys()) && std::ranges::equal(a.values(), b.values());
+}
+
+struct ThrowingHash {
+    size_t operator()(const int key) const {
+        if (key == 123456) {
+            throw std::runtime_error("Unhashable");
+        }
+        return static_cast<size_t>(key);
+    }
+};
+}
+
+TEST_CASE("Parallel construction") {
+    const auto items = repeated_items(300000);
+    const Dict<std::string, int> expected(items);
+
+    for (const size_t threads: {1, 2, 3, 8}) {
+        const Dict<std::string, int> dict(items, Parallel{threads});
+        CHECK(same_items(dict, expected));
+    }
+
+    auto moved_items = items;
+    const Dict<std::string, int> moved(std::move(moved_items), Parallel{4});
+    CHECK(same_items(moved, expected));
+
+    // Too few items to divide between threads
+    const std::vector<Item<std::string, int> > few{{"a", 1}, {"b", 2}, {"a", 3}};
+    CHECK(same_items(Dict<std::string, int>(few, Parallel{8}), Dict<std::string, int>(few)));
+}
+
+TEST_CASE("Parallel update") {
+    Dict<std::string, int> base;
+    for (int i = 0; i < 100000; i += 2) {
+        base["key " + std::to_string(i)] = -i;
+    }
+    // Leave tombstones in both dictionaries
+    for (int i = 0; i < 100000; i += 6) {
+        base.del("key " + std::to_string(i));
+    }
+
+    const auto items = repeated_items(300000);
+    auto expected = base;
+    expected.update(items);
+    auto dict = base;
+    dict.update(items, Parallel{4});
+    CHECK(same_items(dict, expected));
+
+    Dict<std::string, int> other(items);
+    for (int i = 0; i < 100000; i += 5) {
+        other.del("key " + std::to_string(i));
+    }
+    expected = base;
+    expected.update(other);
+    dict = base;
+    dict.update(other, Parallel{4});
+    CHECK(same_items(dict, expected));
+
+    dict = base;
+    dict.update(std::move(other), Parallel{4});
+    CHECK(same_items(dict, expected));
+    CHECK(other.empty());
+
+    // Into an empty dictionary, and from itself
+    Dict<std::string, int> empty;
+    empty.update(expected, Parallel{3});
+    CHECK(same_items(empty, expected));
+    empty.update(empty, Parallel{3});
+    CHECK(same_items(empty, expected));
+}
+
+TEST_CASE("Parallel fromkeys") {
+    std::vector<int> keys;
+    for (int i = 0; i < 200000; ++i) {
+        keys.push_back(i * 31 % 50000);
+    }
+    const auto expected = dictcpp::fromkeys<int, double>(keys, 0.5);
+    const auto dict = dictcpp::fromkeys<int, double>(keys, 0.5, Parallel{4});
+    CHECK(dict.size() == 50000);
+    CHECK(same_items(dict, expected));
+
+    const auto defaults = dictcpp::fromkeys<int, std::string>(keys, std::nullopt, Parallel{4});
+    CHECK(std::ranges::equal(defaults.keys(), expected.keys()));
+    CHECK(std::ranges::all_of(defaults.values(), [](const std::string &value) { return value.empty(); }));
+}
+
+TEST_CASE("Parallel transform") {
+    Dict<int, long long> squares;
+    Dict<int, bool> even;
+    for (int i = 0; i < 100000; ++i) {
+        squares[i] = i;
+        even[i] = false;
+    }
+    for (int i = 0; i < 100000; i += 7) {
+        squares.del(i);
+        even.del(i);
+    }
+
+    squares.transform_values([](const int, const long long value) { return value * value; }, Parallel{4});
+    for (const auto &[key, value]: squares.items()) {
+        CHECK(value == static_cast<long long>(key) * key);
+    }
+    CHECK(squares.size() == 100000 - 14286);
+
+    even.transform_values([](const int key, bool) { return key % 2 == 0; }, Parallel{3});
+    CHECK(even.count() == 50000 - 7143);
+    CHECK(even.at(2));
+    CHECK_FALSE(even.at(3));
+
+    Dict<int, std::string> names{{1, "one"}, {2, "two"}};
+    names.transform_values([](int, const std::string &name) { return name + "!"; });
+    CHECK(names.at(2) == "two!");
+}
+
+TEST_CASE("Parallel operations propagate exceptions") {
+    std::vector<Item<int, int> > items;
+    for (int i = 0; i < 200000; ++i) {
+        items.push_back({i, i});
+    }
+    Dict<int, int, ThrowingHash> dict{{-1, -1}};
+    CHECK_THROWS_AS(dict.update(items, Parallel{4}), std::runtime_error);
+    CHECK(dict.size() == 1);
+    CHECK(dict.at(-1) == -1);
+}
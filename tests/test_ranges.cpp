@@ -0,0 +1,153 @@
+#include "dict_ranges.hpp"
+
+#include "catch.hpp"
+
+#include <cstddef>
+#include <map>
+#include <memory_resource>
+#include <ranges>
+#include <string>
+#include <vector>
+
+using dictcpp::Dict;
+using dictcpp::filter_items;
+using dictcpp::map_keys;
+using dictcpp::map_values;
+using dictcpp::select_keys;
+using dictcpp::to_dict;
+
+namespace {
+// Memory resource counting the allocations made from it
+class CountingResource : public std::pmr::memory_resource {
+    void *do_allocate(const std::size_t bytes, const std::size_t alignment) override {
+        allocations++;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, const std::size_t bytes, const std::size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+
+public:
+    std::size_t allocations = 0;
+};
+
+Dict<std::string, int> numbers(const int count) {
+    Dict<std::string, int> dict;
+    for (int i = 0; i < count; ++i) {
+        dict["n" + std::to_string(i)] = i;
+    }
+    return dict;
+}
+}
+
+TEST_CASE("Pipelines keep the insertion order") {
+    const auto dict = numbers(10);
+
+    const auto result = dict
+                        | filter_items([](const std::string &, const int value) { return value % 3 == 0; })
+                        | map_values([](const int value) { return std::to_string(value * 10); })
+                        | map_keys([](const std::string &key) { return key + "!"; })
+                        | to_dict();
+    CHECK(std::ranges::equal(result.keys(), std::vector<std::string>{"n0!", "n3!", "n6!", "n9!"}));
+    CHECK(std::ranges::equal(result.values(), std::vector<std::string>{"0", "30", "60", "90"}));
+
+    // Constructing or updating a dictionary from a pipeline
+    const Dict<std::string, int> odd(dict | filter_items([](const std::string &, const int value) { return value % 2; }));
+    CHECK(std::ranges::equal(odd.values(), std::vector{1, 3, 5, 7, 9}));
+
+    // The values of boolean dictionaries are materialised as `bool`s
+    const Dict<int, bool> flags{{1, true}, {2, false}, {3, true}};
+    const Dict<int, bool> set = flags | filter_items([](int, const bool value) { return value; }) | to_dict();
+    CHECK(std::ranges::equal(set.keys(), std::vector{1, 3}));
+
+    auto updated = numbers(3);
+    updated.update(dict | map_values([](const int value) { return -value; }));
+    CHECK(updated.size() == 10);
+    CHECK(updated.at("n2") == -2);
+    CHECK(updated.keys().back() == "n9");
+}
+
+TEST_CASE("Pipelines are lazy") {
+    auto dict = numbers(100);
+    int calls = 0;
+    auto pipeline = dict | map_values([&calls](const int value) {
+        calls++;
+        return value * 2;
+    });
+    CHECK(calls == 0);
+    CHECK(pipeline.size_hint() == 100);
+
+    // Only the items taken are computed, and the source is read as iterated
+    dict["n1"] = 1000;
+    auto first = pipeline | std::views::take(2);
+    CHECK(std::ranges::equal(first | std::views::transform([](const auto &item) { return item.value; }),
+                             std::vector{0, 2000}));
+    CHECK(calls == 2);
+
+    // Filters bound the size by that of their source
+    auto filtered = pipeline | filter_items([](const std::string &, const int value) { return value > 150; });
+    CHECK(filtered.size_hint() == 100);
+    CHECK(to_dict(filtered).size() == 25);
+}
+
+TEST_CASE("Selecting keys") {
+    const auto dict = numbers(10);
+
+    const auto selected = dict | select_keys({"n7", "missing", "n2", "n7"}) | to_dict();
+    CHECK(std::ranges::equal(selected.keys(), std::vector<std::string>{"n7", "n2"}));
+    CHECK(selected.at("n2") == 2);
+
+    const std::vector<std::string> keys{"n4", "n5"};
+    auto view = dict | select_keys(keys);
+    CHECK(view.size_hint() == 2);
+    CHECK(to_dict(view | map_values([](const int value) { return value + 0.5; })).at("n5") == 5.5);
+
+    // Values can be modified through a selection of a non-const dictionary
+    auto mutable_dict = numbers(10);
+    for (auto &&[key, value]: mutable_dict | select_keys(keys)) {
+        value = 0;
+    }
+    CHECK(mutable_dict.at("n4") == 0);
+    CHECK(mutable_dict.at("n6") == 6);
+}
+
+TEST_CASE("Pipelines over other ranges of pairs") {
+    const std::map<int, std::string> map{{3, "c"}, {1, "a"}, {2, "b"}};
+    const auto dict = map
+                      | map_keys([](const int key) { return key * 10; })
+                      | filter_items([](const int key, const std::string &) { return key != 20; })
+                      | to_dict();
+    CHECK(std::ranges::equal(dict.keys(), std::vector{10, 30}));
+
+    // Keys mapped to the same key keep the last value
+    const auto collapsed = map | map_keys([](int) { return 0; }) | to_dict();
+    CHECK(collapsed.size() == 1);
+    CHECK(collapsed.at(0) == "c");
+}
+
+TEST_CASE("Materialising a pipeline allocates once") {
+    const auto dict = numbers(1000);
+    auto pipeline = dict
+                    | filter_items([](const std::string &, const int value) { return value % 2 == 0; })
+                    | map_values([](const int value) { return value * 2; })
+                    | map_keys([](const std::string &key) { return key.size(); });
+
+    CountingResource resource;
+    std::pmr::memory_resource *previous = std::pmr::set_default_resource(&resource);
+    dictcpp::pmr::Dict<std::size_t, int> reserved;
+    reserved.reserve(1000);
+    const std::size_t once = resource.allocations;
+    resource.allocations = 0;
+
+    const auto result = pipeline | to_dict<dictcpp::pmr::Dict<std::size_t, int> >();
+    CHECK(resource.allocations == once);
+    std::pmr::set_default_resource(previous);
+
+    CHECK(result.size() == 3);
+    CHECK(result.at(4) == 1996);
+}
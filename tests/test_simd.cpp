@@ -0,0 +1,93 @@
+#include "dictcpp.hpp"
+
+#include "catch.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using dictcpp::Dict;
+
+namespace {
+enum class Colour : uint8_t { red, green, blue, black };
+
+template<typename T>
+void check_find(const size_t capacity) {
+    std::vector<T> data(capacity);
+    for (size_t n = 0; n <= capacity; ++n) {
+        for (size_t i = 0; i < capacity; ++i) {
+            data[i] = static_cast<T>(i + 1);
+        }
+        for (size_t i = 0; i < n; ++i) {
+            CHECK(dictcpp::simd::find(data.data(), n, capacity, static_cast<T>(i + 1)) == i);
+        }
+        // Elements beyond `n` are never found
+        for (size_t i = n; i < capacity; ++i) {
+            CHECK(dictcpp::simd::find(data.data(), n, capacity, static_cast<T>(i + 1)) == n);
+        }
+        CHECK(dictcpp::simd::find(data.data(), n, capacity, T{}) == n);
+    }
+}
+}
+
+TEST_CASE("Vectorised search") {
+    for (const size_t capacity: {1, 3, 4, 16, 17, 40, 64}) {
+        check_find<char>(capacity);
+        check_find<int16_t>(capacity);
+        check_find<int>(capacity);
+        check_find<uint64_t>(capacity);
+    }
+}
+
+TEST_CASE("Vectorised search of 64-bit keys compares both halves") {
+    const std::vector<uint64_t> data{1, uint64_t{1} << 32, (uint64_t{1} << 32) + 1, 0};
+    CHECK(dictcpp::simd::find(data.data(), 4, 4, uint64_t{1}) == 0);
+    CHECK(dictcpp::simd::find(data.data(), 4, 4, uint64_t{1} << 32) == 1);
+    CHECK(dictcpp::simd::find(data.data(), 4, 4, (uint64_t{1} << 32) + 1) == 2);
+    CHECK(dictcpp::simd::find(data.data(), 4, 4, uint64_t{2} << 32) == 4);
+}
+
+TEST_CASE("Small dictionaries with integral keys") {
+    auto colours = Dict<Colour, int>{{Colour::red, 1}, {Colour::green, 2}, {Colour::blue, 3}};
+    CHECK(colours.at(Colour::green) == 2);
+    CHECK_FALSE(colours.contains(Colour::black));
+
+    auto chars = Dict<char, int>();
+    for (char c = 'a'; c < 'a' + static_cast<char>(Dict<char, int>::inline_capacity); ++c) {
+        chars[c] = c - 'a';
+    }
+    for (char c = 'a'; c < 'a' + static_cast<char>(Dict<char, int>::inline_capacity); ++c) {
+        CHECK(chars.at(c) == c - 'a');
+    }
+    CHECK_FALSE(chars.contains('A'));
+
+    int values[3] = {};
+    auto pointers = Dict<int *, int>{{&values[0], 0}, {&values[2], 2}};
+    CHECK(pointers.at(&values[2]) == 2);
+    CHECK_FALSE(pointers.contains(&values[1]));
+}
+
+TEST_CASE("Hashed dictionaries with integral keys") {
+    auto dict = Dict<uint64_t, uint64_t>();
+    constexpr uint64_t n = 5000;
+    for (uint64_t i = 0; i < n; ++i) {
+        dict[i << 32] = i;
+    }
+    for (uint64_t i = 0; i < n; ++i) {
+        REQUIRE(dict.at(i << 32) == i);
+        REQUIRE_FALSE(dict.contains((i << 32) + 1));
+    }
+
+    // Repeated deletion and insertion reuses deleted slots without filling the table
+    for (int round = 0; round < 5; ++round) {
+        for (uint64_t i = 0; i < n; i += 2) {
+            dict.del(i << 32);
+        }
+        for (uint64_t i = 0; i < n; i += 2) {
+            dict[i << 32] = i;
+        }
+    }
+    REQUIRE(dict.size() == n);
+    for (uint64_t i = 0; i < n; ++i) {
+        REQUIRE(dict.at(i << 32) == i);
+    }
+}
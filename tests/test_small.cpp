@@ -0,0 +1,105 @@
+#include "dictcpp.hpp"
+
+#include "catch.hpp"
+
+#include <string>
+#include <string_view>
+
+using dictcpp::Dict;
+
+namespace {
+// Whether `object` lies within the storage of `dict`
+template<typename DictType, typename T>
+bool is_inline(const DictType &dict, const T &object) {
+    const auto begin = reinterpret_cast<const char *>(&dict);
+    const auto address = reinterpret_cast<const char *>(&object);
+    return std::less_equal<>()(begin, address) && std::less<>()(address, begin + sizeof(DictType));
+}
+}
+
+TEST_CASE("Small dictionaries are stored inline") {
+    auto dict = Dict<int, int>();
+    for (int i = 0; i < static_cast<int>(Dict<int, int>::inline_capacity); ++i) {
+        dict[i] = i * i;
+    }
+    CHECK(dict.at(3) == 9);
+    CHECK(dict.contains(0));
+    CHECK_FALSE(dict.contains(-1));
+    dict.del(2);
+    CHECK(dict.pop(4) == 16);
+    dict[100] = 1;
+    CHECK(dict.keys().back() == 100);
+    CHECK(is_inline(dict, dict.keys().front()));
+    CHECK(is_inline(dict, dict.values().back()));
+
+    const auto moved = std::move(dict);
+    CHECK(moved.keys().back() == 100);
+    CHECK(is_inline(moved, moved.keys().front()));
+
+    auto large = moved;
+    large[-1] = 0;
+    large[-2] = 0;
+    CHECK_FALSE(is_inline(large, large.keys().front()));
+    large.del(-1);
+    large.del(-2);
+    large.shrink_to_fit();
+    CHECK(is_inline(large, large.keys().front()));
+}
+
+TEST_CASE("Growing beyond the inline capacity") {
+    auto dict = Dict<int, std::string, dictcpp::Hash<int>, std::equal_to<>, 4>();
+    for (int i = 0; i < 4; ++i) {
+        dict[i] = std::to_string(i);
+    }
+    CHECK(dict.capacity() == 4);
+
+    dict[4] = "4";
+    CHECK(dict.capacity() > 4);
+    REQUIRE(dict.size() == 5);
+    for (int i = 0; i < 5; ++i) {
+        CHECK(dict.at(i) == std::to_string(i));
+    }
+    CHECK(dictcpp::list(dict) == std::vector<int>{0, 1, 2, 3, 4});
+
+    // Deleting entries compacts the dictionary back to the inline layout
+    dict.del(0);
+    dict.del(1);
+    dict.del(2);
+    REQUIRE(dict.size() == 2);
+    CHECK(dict.capacity() == 4);
+    CHECK(dictcpp::list(dict) == std::vector<int>{3, 4});
+    CHECK(dict.at(4) == "4");
+    dict[5] = "5";
+    dict[6] = "6";
+    CHECK(dictcpp::list(dict) == std::vector<int>{3, 4, 5, 6});
+
+    dict.clear();
+    CHECK(dict.capacity() == 4);
+}
+
+TEST_CASE("Small dictionaries with string keys") {
+    auto dict = Dict<std::string, int>();
+    REQUIRE(Dict<std::string, int>::inline_capacity > 0);
+
+    dict["accept"] = 1;
+    dict["host"] = 2;
+    CHECK(dict.at(std::string_view("host")) == 2);
+    CHECK(dict.get("accept") == 1);
+    CHECK_FALSE(dict.contains("cookie"));
+
+    dict.del("accept");
+    CHECK(dict.size() == 1);
+    CHECK(dict.keys().front() == "host");
+    CHECK(dict.popitem().key == "host");
+    CHECK(dict.empty());
+}
+
+TEST_CASE("No inline storage") {
+    auto dict = Dict<int, int, dictcpp::Hash<int>, std::equal_to<>, 0>();
+    CHECK(dict.capacity() == 0);
+    dict[1] = 1;
+    dict[2] = 2;
+    CHECK(dict.at(2) == 2);
+    dict.del(1);
+    CHECK(dictcpp::len(dict) == 1);
+}
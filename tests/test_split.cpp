@@ -0,0 +1,154 @@
+#include "split_dict.hpp"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using dictcpp::SplitDict;
+
+namespace {
+template<typename D, typename K>
+concept CanLookUp = requires(D &dict, const K &key) {
+    dict.contains(key);
+    dict.at(key);
+    dict.get(key);
+    dict.pop(key);
+    dict.del(key);
+};
+}
+
+TEST_CASE("Split dictionaries share their keys") {
+    const auto columns = dictcpp::shared_keys<std::string>({"id", "name", "email"});
+
+    std::vector<SplitDict<std::string, std::string>> records;
+    for (int i = 0; i < 100; ++i) {
+        auto &record = records.emplace_back(columns);
+        record["id"] = std::to_string(i);
+        record["name"] = "user " + std::to_string(i);
+        record["email"] = "user" + std::to_string(i) + "@example.com";
+    }
+
+    CHECK(columns.use_count() == 101);
+    for (const auto &record: records) {
+        CHECK(record.key_table() == columns);
+    }
+    CHECK(records[42].at("name") == "user 42");
+    CHECK(records[42].at(std::string_view("id")) == "42");
+    CHECK(records[42].get("phone", "none") == "none");
+    CHECK_THROWS_AS(records[42].at("phone"), std::out_of_range);
+    CHECK(dictcpp::len(records[0]) == 3);
+    CHECK(std::ranges::equal(records[7].keys(), std::vector<std::string>{"id", "name", "email"}));
+    CHECK(std::ranges::equal(records[7].values(), std::vector<std::string>{"7", "user 7", "user7@example.com"}));
+
+    // Fewer keys, in order, and removing the last key still share the table
+    SplitDict<std::string, std::string> partial(columns, {"x"});
+    CHECK(partial.size() == 1);
+    CHECK_FALSE(partial.contains("name"));
+    partial.insert_or_assign("name", "y");
+    CHECK(partial.pop("name") == "y");
+    CHECK(partial.key_table() == columns);
+
+    CHECK_THROWS_AS((SplitDict<std::string, std::string>(columns, {"1", "2", "3", "4"})), std::length_error);
+
+    // Copies share the table
+    const auto copy = records[1];
+    CHECK(copy.key_table() == columns);
+    CHECK(copy.at("id") == "1");
+}
+
+TEST_CASE("Split dictionaries diverge from the shared keys") {
+    const auto columns = dictcpp::shared_keys<std::string>({"a", "b", "c"});
+
+    SplitDict<std::string, int> out_of_order(columns);
+    out_of_order["a"] = 1;
+    out_of_order["c"] = 3;
+    CHECK(out_of_order.key_table() != columns);
+    CHECK(dictcpp::list(out_of_order.to_dict()) == std::vector<std::string>{"a", "c"});
+
+    SplitDict<std::string, int> extra(columns, {1, 2, 3});
+    CHECK(extra.try_emplace("d", 4));
+    CHECK_FALSE(extra.try_emplace("d", 5));
+    CHECK(extra.key_table() != columns);
+    CHECK(std::ranges::equal(extra.keys(), std::vector<std::string>{"a", "b", "c", "d"}));
+
+    SplitDict<std::string, int> deleted(columns, {1, 2, 3});
+    deleted.del("a");
+    CHECK(deleted.key_table() != columns);
+    CHECK(std::ranges::equal(deleted.values(), std::vector{2, 3}));
+    CHECK(deleted.at("c") == 3);
+    CHECK_FALSE(deleted.contains("a"));
+
+    // The shared table and the other dictionaries are unchanged
+    CHECK(columns->size() == 3);
+    CHECK(columns->position("b") == 1);
+    SplitDict<std::string, int> shared(columns, {1, 2, 3});
+    CHECK(shared.key_table() == columns);
+    CHECK(shared.at("a") == 1);
+}
+
+TEST_CASE("Heterogeneous lookups in a split dictionary") {
+    SplitDict<std::string, int> dict{{"a", 1}, {"b", 2}, {"c", 3}};
+    CHECK(dict.contains(std::string_view("a")));
+    CHECK(dict.get(std::string_view("b")) == 2);
+    CHECK(dict.key_table()->position(std::string_view("c")) == 2);
+    CHECK(dict.pop(std::string_view("c")) == 3);
+    dict.del(std::string_view("b"));
+    CHECK(dict.size() == 1);
+
+    // Without a transparent hash, keys are converted to `Key` at the call, and other types of
+    // keys are rejected there
+    using Plain = SplitDict<std::string, int, std::hash<std::string> >;
+    Plain plain{{"a", 1}};
+    CHECK(plain.at("a") == 1);
+    CHECK(plain.get("b", 0) == 0);
+    static_assert(CanLookUp<SplitDict<std::string, int>, std::string_view>);
+    static_assert(!CanLookUp<Plain, std::string_view>);
+}
+
+TEST_CASE("Private split dictionaries") {
+    SplitDict<int, int> dict{{1, 10}, {2, 20}};
+    for (int i = 3; i <= 1000; ++i) {
+        dict[i] = i * 10;
+    }
+    // The table is private, so is modified in place
+    const auto *table = dict.key_table().get();
+
+    CHECK(dict.pop(1000) == 10000);
+    for (int i = 2; i < 1000; i += 2) {
+        CHECK(dict.pop(i) == i * 10);
+    }
+    CHECK(dict.size() == 500);
+    CHECK(dict.key_table().get() == table);
+    for (int i = 1; i <= 1000; ++i) {
+        CHECK(dict.contains(i) == (i % 2 == 1));
+    }
+    CHECK(dict.keys().front() == 1);
+    CHECK(dict.keys().back() == 999);
+
+    for (auto &&[key, value]: dict.items()) {
+        value = -key;
+    }
+    CHECK(dict.get(501) == -501);
+
+    dict.clear();
+    CHECK(dict.empty());
+    CHECK(dict.begin() == dict.end());
+}
+
+TEST_CASE("Split dictionaries with boolean values") {
+    const auto permissions = dictcpp::shared_keys<std::string>({"read", "write", "delete"});
+
+    SplitDict<std::string, bool> user(permissions, {true, false});
+    CHECK(user.at("read"));
+    CHECK_FALSE(user.at("write"));
+    user.at("write") = true;
+    user["delete"] = true;
+    CHECK(std::ranges::count(user.values(), true) == 3);
+    CHECK(user.key_table() == permissions);
+
+    user.del("read");
+    CHECK(std::ranges::equal(user.values(), std::vector{true, true}));
+}
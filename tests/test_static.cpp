@@ -0,0 +1,90 @@
+#include "static_dict.hpp"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using dictcpp::StaticDict;
+
+namespace {
+enum class Colour { Red, Green, Blue };
+
+constexpr auto colour_names = dictcpp::static_dict<Colour, std::string_view>({
+    {Colour::Red, "red"}, {Colour::Green, "green"}, {Colour::Blue, "blue"}
+});
+
+constexpr auto opcodes = dictcpp::static_dict<std::string_view, int>({
+    {"add", 0}, {"sub", 1}, {"mul", 2}, {"div", 3}, {"add", 4}
+});
+
+// Evaluated entirely at compile time
+static_assert(colour_names.size() == 3);
+static_assert(colour_names[Colour::Green] == "green");
+static_assert(opcodes.size() == 4);
+static_assert(opcodes.at("mul") == 2);
+static_assert(opcodes["add"] == 4);
+static_assert(opcodes.contains("div"));
+static_assert(!opcodes.contains("mod"));
+static_assert(opcodes.get("mod", -1) == -1);
+static_assert(opcodes.find("sub")->value == 1);
+static_assert(*opcodes.keys().begin() == "add");
+static_assert(opcodes.values()[3] == 3);
+static_assert(dictcpp::len(opcodes) == 4);
+
+constexpr int sum_values() {
+    int sum = 0;
+    for (const auto &[key, value]: opcodes.items()) {
+        sum += value;
+    }
+    return sum;
+}
+
+static_assert(sum_values() == 10);
+
+constexpr StaticDict<int, int, 64> squares() {
+    StaticDict<int, int, 64> dict;
+    for (int i = 0; i < 64; ++i) {
+        dict.insert_or_assign(i * i, i);
+    }
+    return dict;
+}
+
+constinit StaticDict<int, int, 64> square_roots = squares();
+}
+
+TEST_CASE("Static dictionary lookups") {
+    // Keys only known at run time
+    const std::string name = "div";
+    CHECK(opcodes.at(name) == 3);
+    CHECK_FALSE(opcodes.contains(name + "x"));
+    CHECK_THROWS_AS(opcodes.at("mod"), std::out_of_range);
+    CHECK_THROWS_AS(opcodes.get("mod"), std::runtime_error);
+    CHECK(opcodes.find("mod") == opcodes.items().end());
+
+    CHECK(dictcpp::list(opcodes) == std::vector<std::string_view>{"add", "sub", "mul", "div"});
+    CHECK(std::ranges::equal(colour_names.values(), std::vector<std::string_view>{"red", "green", "blue"}));
+
+    for (int i = 0; i < 64; ++i) {
+        CHECK(square_roots[i * i] == i);
+    }
+    CHECK_FALSE(square_roots.contains(2));
+}
+
+TEST_CASE("Static dictionary capacity") {
+    StaticDict<int, std::string_view, 3> dict{{1, "one"}};
+    CHECK(dict.max_size == 3);
+    CHECK(dict.insert_or_assign(2, "two"));
+    CHECK_FALSE(dict.insert_or_assign(1, "uno"));
+    CHECK(dict.insert_or_assign(3, "three"));
+    CHECK_THROWS_AS(dict.insert_or_assign(4, "four"), std::length_error);
+    CHECK(dict.size() == 3);
+    CHECK(dict[1] == "uno");
+
+    constexpr StaticDict<int, int, 4> empty;
+    static_assert(empty.empty());
+    static_assert(empty.begin() == empty.end());
+    static_assert(!empty.contains(0));
+}
@@ -0,0 +1,180 @@
+#include "dictcpp.hpp"
+
+#include "catch.hpp"
+
+#include <string>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using dictcpp::Dict;
+using dictcpp::DictStats;
+
+namespace {
+// Every key has the same hash, so that lookups probe a long sequence of slots
+struct CollidingHash {
+    size_t operator()(int) const {
+        return 42;
+    }
+};
+}
+
+TEST_CASE("Statistics of a dictionary") {
+    Dict<int, int> dict;
+    for (int i = 0; i < 1000; ++i) {
+        dict[i] = i;
+    }
+    for (int i = 0; i < 2000; ++i) {
+        dict.contains(i);
+    }
+    dict.del(0);
+    dict.pop(1);
+
+    const auto &stats = dict.stats();
+    CHECK(stats.insertions == 1000);
+    CHECK(stats.deletions == 2);
+    CHECK(stats.lookups == 1000 + 2000 + 2);
+    CHECK(stats.hits == 1000 + 2);
+    CHECK(stats.misses == 1000 + 1000);
+    CHECK(stats.growths > 0);
+    CHECK(stats.rebuilds >= stats.growths);
+    CHECK(stats.probes >= 2000);
+    CHECK(stats.max_probe_length >= 1);
+    CHECK(stats.allocations > 0);
+    CHECK(stats.allocated_bytes >= 1000 * 3 * sizeof(int));
+
+    // Pre-sizing the dictionary avoids the growths
+    Dict<int, int> reserved;
+    reserved.reserve(1000);
+    reserved.reset_stats();
+    for (int i = 0; i < 1000; ++i) {
+        reserved[i] = i;
+    }
+    CHECK(reserved.stats().growths == 0);
+    CHECK(reserved.stats().allocations == 0);
+
+    // Copies start with their own statistics
+    const auto copy = dict;
+    CHECK(copy.stats() == DictStats{});
+    CHECK(copy.at(5) == 5);
+    CHECK(copy.stats().hits == 1);
+    CHECK(dict.stats().hits == 1000 + 2);
+
+    std::ostringstream out;
+    out << dict.stats();
+    CHECK(out.str().find("insertions=1000") != std::string::npos);
+}
+
+TEST_CASE("Moving items to the front rebuilds rarely") {
+    Dict<int, int> dict;
+    for (int i = 0; i < 1000; ++i) {
+        dict[i] = i;
+    }
+    dict.reset_stats();
+    for (int i = 0; i < 3000; ++i) {
+        dict.move_to_end(i * 7 % 1000, false);
+    }
+    CHECK(dict.stats().rebuilds <= 8);
+    CHECK(dict.stats().growths == 0);
+    CHECK(dict.size() == 1000);
+    CHECK(dict.keys().front() == 2999 * 7 % 1000);
+    CHECK(dict.keys()[1] == 2998 * 7 % 1000);
+    for (int i = 0; i < 1000; ++i) {
+        CHECK(dict.at(i) == i);
+    }
+}
+
+TEST_CASE("Statistics of concurrent reads") {
+    Dict<int, int> dict;
+    for (int i = 0; i < 1000; ++i) {
+        dict[i] = i;
+    }
+    dict.reset_stats();
+
+    // Lookups only read the dictionary (their counts are atomic)
+    const auto &shared = dict;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&shared] {
+            for (int i = 0; i < 2000; ++i) {
+                shared.contains(i);
+            }
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    CHECK(dict.stats().lookups == 4 * 2000);
+    CHECK(dict.stats().hits == 4 * 1000);
+    CHECK(dict.stats().max_probe_length >= 1);
+}
+
+TEST_CASE("Finding pathological dictionaries") {
+    const auto before = Dict<int, int, CollidingHash>::total_stats();
+    {
+        std::vector<Dict<int, int, CollidingHash> > dicts(10);
+        for (int i = 0; i < 200; ++i) {
+            dicts[7][i] = i;
+        }
+        for (int i = 0; i < 20; ++i) {
+            dicts[3][i] = i;
+        }
+
+        const Dict<int, int, CollidingHash> *worst = nullptr;
+        size_t instances = 0;
+        Dict<int, int, CollidingHash>::for_each_instance([&](const Dict<int, int, CollidingHash> &dict) {
+            instances++;
+            if (worst == nullptr || dict.stats().max_probe_length > worst->stats().max_probe_length) {
+                worst = &dict;
+            }
+        });
+        CHECK(instances == 10);
+        CHECK(worst == &dicts[7]);
+        CHECK(worst->stats().max_probe_length > 10);
+        CHECK(worst->stats().key_comparisons > worst->stats().lookups);
+    }
+
+    // The statistics of destroyed dictionaries are kept in the totals
+    const auto after = Dict<int, int, CollidingHash>::total_stats();
+    CHECK(after.insertions - before.insertions == 220);
+    Dict<int, int, CollidingHash>::for_each_instance([](const auto &) {
+        FAIL("No dictionary is left");
+    });
+}
+
+TEST_CASE("Memory usage") {
+    Dict<std::string, int> dict;
+    const auto empty = dict.memory_usage();
+    CHECK(empty.allocated == sizeof(dict));
+    CHECK(empty.used == 0);
+
+    dict.reserve(10000);
+    for (int i = 0; i < 1000; ++i) {
+        dict[std::to_string(i)] = i;
+    }
+    const auto reserved = dict.memory_usage();
+    CHECK(reserved.used >= 1000 * (sizeof(std::string) + sizeof(int)));
+    CHECK(reserved.allocated > 5 * reserved.used);
+
+    dict.shrink_to_fit();
+    const auto shrunk = dict.memory_usage();
+    CHECK(shrunk.used == reserved.used);
+    CHECK(shrunk.allocated < reserved.allocated);
+    CHECK(shrunk.allocated >= shrunk.used);
+
+    // Deleted entries hold memory until they are removed
+    for (int i = 0; i < 400; ++i) {
+        dict.del(std::to_string(i));
+    }
+    CHECK(dict.memory_usage().used < shrunk.used);
+    CHECK(dict.memory_usage().allocated == shrunk.allocated);
+
+    // Boolean values take a bit each
+    Dict<int, bool> flags;
+    Dict<int, char> chars;
+    for (int i = 0; i < 1000; ++i) {
+        flags[i] = true;
+        chars[i] = 'x';
+    }
+    CHECK(flags.memory_usage().used < chars.memory_usage().used);
+}